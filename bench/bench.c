@@ -0,0 +1,79 @@
+/*
+ * SPDX-FileCopyrightText: 2023 David Jolly <majestic53@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <time.h>
+#include <bench.h>
+
+static const uint8_t LOGO[] =
+{
+    0xCE, 0xED, 0x66, 0x66, 0xCC, 0x0D, 0x00, 0x0B, 0x03, 0x73, 0x00, 0x83, 0x00, 0x0C, 0x00, 0x0D,
+    0x00, 0x08, 0x11, 0x1F, 0x88, 0x89, 0x00, 0x0E, 0xDC, 0xCC, 0x6E, 0xE6, 0xDD, 0xDD, 0xD9, 0x99,
+    0xBB, 0xBB, 0x67, 0x63, 0x6E, 0x0E, 0xEC, 0xCC, 0xDD, 0xDC, 0x99, 0x9F, 0xBB, 0xB9, 0x33, 0x3E,
+};
+
+uint64_t bench_clock(void)
+{
+    struct timespec now = {};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000) + now.tv_nsec;
+}
+
+uint64_t bench_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#else
+    return 0; /* UNSUPPORTED */
+#endif /* __x86_64__ || __i386__ */
+}
+
+uint32_t bench_random(uint32_t *const seed)
+{
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 17;
+    *seed ^= *seed << 5;
+    return *seed;
+}
+
+void bench_report(const char *const name, uint64_t count, uint64_t elapsed, uint64_t cycles)
+{
+    if (!count)
+    {
+        return;
+    }
+    if (cycles)
+    {
+        fprintf(stdout, "%-32s %12lu ops %10.2f ns/op %10.2f cycles/op\n", name, (unsigned long)count, (double)elapsed / count, (double)cycles / count);
+    }
+    else
+    {
+        fprintf(stdout, "%-32s %12lu ops %10.2f ns/op %10s cycles/op\n", name, (unsigned long)count, (double)elapsed / count, "-");
+    }
+}
+
+int bench_rom(uint8_t *const data, uint32_t length, uint8_t id, uint8_t rom, uint8_t ram)
+{
+    uint8_t checksum = 0;
+    if (length < (0x8000U << rom))
+    {
+        return DMGL_ERROR("Invalid rom length -- %u bytes (expecting >= %u bytes)", length, 0x8000U << rom);
+    }
+    for (uint32_t index = 0; index < length; ++index)
+    {
+        data[index] = index / 0x4000; /* BANK NUMBER */
+    }
+    memset(&data[0x0100], 0, 0x50);
+    memcpy(&data[0x0104], LOGO, sizeof (LOGO));
+    memcpy(&data[0x0134], "BENCH", strlen("BENCH"));
+    data[0x0147] = id;
+    data[0x0148] = rom;
+    data[0x0149] = ram;
+    for (uint32_t index = 0x0134; index <= 0x014C; ++index)
+    {
+        checksum = checksum - data[index] - 1;
+    }
+    data[0x014D] = checksum;
+    return EXIT_SUCCESS;
+}
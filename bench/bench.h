@@ -0,0 +1,17 @@
+/*
+ * SPDX-FileCopyrightText: 2023 David Jolly <majestic53@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef DMGL_BENCH_H_
+#define DMGL_BENCH_H_
+
+#include <common.h>
+
+uint64_t bench_clock(void);
+uint64_t bench_cycles(void);
+uint32_t bench_random(uint32_t *const seed);
+void bench_report(const char *const name, uint64_t count, uint64_t elapsed, uint64_t cycles);
+int bench_rom(uint8_t *const data, uint32_t length, uint8_t id, uint8_t rom, uint8_t ram);
+
+#endif /* DMGL_BENCH_H_ */
@@ -0,0 +1,91 @@
+/*
+ * SPDX-FileCopyrightText: 2023 David Jolly <majestic53@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <bench.h>
+#include <system.h>
+
+#define ITERATIONS (1 << 24)
+
+typedef struct
+{
+    const char *name;
+    uint16_t begin;
+    uint16_t end;
+} bench_region_t;
+
+static const bench_region_t REGION[] =
+{
+    { "bus/read/bootrom", 0x0000, 0x00FF, },
+    { "bus/read/rom0", 0x0150, 0x3FFF, },
+    { "bus/read/rom1", 0x4000, 0x7FFF, },
+    { "bus/read/video-ram", 0x8000, 0x9FFF, },
+    { "bus/read/cartridge-ram", 0xA000, 0xBFFF, },
+    { "bus/read/work-ram", 0xC000, 0xDFFF, },
+    { "bus/read/work-ram-mirror", 0xE000, 0xFDFF, },
+    { "bus/read/object-ram", 0xFE00, 0xFE9F, },
+    { "bus/read/input", 0xFF00, 0xFF00, },
+    { "bus/read/timer", 0xFF04, 0xFF07, },
+    { "bus/read/audio", 0xFF10, 0xFF26, },
+    { "bus/read/video", 0xFF40, 0xFF4B, },
+    { "bus/read/high-ram", 0xFF80, 0xFFFE, },
+    { "bus/read/interrupt", 0xFFFF, 0xFFFF, },
+};
+
+static struct
+{
+    dmgl_t context;
+    volatile uint8_t sink;
+} g_bench = {};
+
+static void bench_region(const bench_region_t *const region)
+{
+    uint64_t cycles = 0, elapsed = 0;
+    uint32_t length = (region->end - region->begin) + 1;
+    cycles = bench_cycles();
+    elapsed = bench_clock();
+    for (uint32_t index = 0; index < ITERATIONS; ++index)
+    {
+        g_bench.sink = dmgl_read(region->begin + (index % length));
+    }
+    elapsed = bench_clock() - elapsed;
+    cycles = bench_cycles() - cycles;
+    bench_report(region->name, ITERATIONS, elapsed, cycles);
+}
+
+int main(void)
+{
+    int result = EXIT_SUCCESS;
+    dmgl_instance_t *instance = NULL;
+    g_bench.context.rom.length = 0x8000U << 5;
+    g_bench.context.ram.length = 17 * 0x2000;
+    if (!(g_bench.context.rom.data = calloc(g_bench.context.rom.length, sizeof (uint8_t)))
+            || !(g_bench.context.ram.data = calloc(g_bench.context.ram.length, sizeof (uint8_t))))
+    {
+        fprintf(stderr, "Failed to allocate buffer\n");
+        result = EXIT_FAILURE;
+    }
+    else if ((result = bench_rom(g_bench.context.rom.data, g_bench.context.rom.length, 0x03, 5, 3)) != EXIT_SUCCESS)
+    {
+        fprintf(stderr, "%s\n", dmgl_error());
+    }
+    else if (!(instance = dmgl_create(&g_bench.context)))
+    { /* NO CLIENT IS NEEDED, SINCE THE INSTANCE IS NEVER RUN, ONLY READ */
+        fprintf(stderr, "%s\n", dmgl_error());
+        result = EXIT_FAILURE;
+    }
+    else
+    {
+        dmgl_select(instance);
+        dmgl_write(0x0000, 0x0A); /* RAM ENABLE */
+        for (uint32_t index = 0; index < sizeof (REGION) / sizeof (*REGION); ++index)
+        {
+            bench_region(&REGION[index]);
+        }
+        dmgl_destroy(instance);
+    }
+    free(g_bench.context.ram.data);
+    free(g_bench.context.rom.data);
+    return result;
+}
@@ -0,0 +1,106 @@
+/*
+ * SPDX-FileCopyrightText: 2023 David Jolly <majestic53@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <bench.h>
+#include <memory.h>
+
+#define ITERATIONS (1 << 24)
+#define ROM_LENGTH (0x8000U << 6)
+
+typedef struct
+{
+    const char *name;
+    uint8_t id;
+    uint8_t rom;
+    uint8_t ram;
+} bench_mapper_t;
+
+static const bench_mapper_t MAPPER[] =
+{
+    { "memory/mapper/mbc0", 0x00, 0, 0, },
+    { "memory/mapper/mbc1", 0x03, 5, 3, },
+    { "memory/mapper/mbc2", 0x06, 3, 0, },
+    { "memory/mapper/mbc3", 0x13, 5, 3, },
+    { "memory/mapper/mbc5", 0x1B, 6, 4, },
+};
+
+static struct
+{
+    uint16_t address[1024];
+    dmgl_t context;
+    dmgl_memory_t memory;
+    volatile uint8_t sink;
+} g_bench = {};
+
+static int bench_mapper(const bench_mapper_t *const mapper)
+{
+    int result = EXIT_SUCCESS;
+    uint64_t cycles = 0, elapsed = 0;
+    uint8_t (*read)(const dmgl_memory_t *const memory, uint16_t address) = NULL;
+    memset(&g_bench.memory, 0, sizeof (g_bench.memory));
+    if ((result = bench_rom(g_bench.context.rom.data, ROM_LENGTH, mapper->id, mapper->rom, mapper->ram)) != EXIT_SUCCESS)
+    {
+        return result;
+    }
+    g_bench.context.rom.length = 0x8000U << mapper->rom;
+    g_bench.context.ram.length = 17 * 0x2000;
+    if ((result = dmgl_memory_initialize(&g_bench.memory, &g_bench.context)) != EXIT_SUCCESS)
+    {
+        return result;
+    }
+    g_bench.memory.mapper.write(&g_bench.memory, 0x0000, 0x0A); /* RAM ENABLE */
+    g_bench.memory.mapper.write(&g_bench.memory, 0x2100, 0x02); /* ROM BANK */
+    read = g_bench.memory.mapper.read;
+    cycles = bench_cycles();
+    elapsed = bench_clock();
+    for (uint32_t index = 0; index < ITERATIONS; ++index)
+    {
+        g_bench.sink = read(&g_bench.memory, g_bench.address[index & 1023]);
+    }
+    elapsed = bench_clock() - elapsed;
+    cycles = bench_cycles() - cycles;
+    bench_report(mapper->name, ITERATIONS, elapsed, cycles);
+    dmgl_memory_uninitialize(&g_bench.memory);
+    return EXIT_SUCCESS;
+}
+
+int main(void)
+{
+    uint32_t seed = 0x0BADC0DE;
+    int result = EXIT_SUCCESS;
+    for (uint32_t index = 0; index < 1024; ++index)
+    {
+        switch (bench_random(&seed) % 3)
+        {
+            case 0: /* ROM 0 */
+                g_bench.address[index] = bench_random(&seed) & 0x3FFF;
+                break;
+            case 1: /* ROM 1-N */
+                g_bench.address[index] = 0x4000 | (bench_random(&seed) & 0x3FFF);
+                break;
+            default: /* RAM */
+                g_bench.address[index] = 0xA000 | (bench_random(&seed) & 0x1FFF);
+                break;
+        }
+    }
+    g_bench.context.rom.length = ROM_LENGTH;
+    g_bench.context.ram.length = 17 * 0x2000;
+    if (!(g_bench.context.rom.data = calloc(g_bench.context.rom.length, sizeof (uint8_t)))
+            || !(g_bench.context.ram.data = calloc(g_bench.context.ram.length, sizeof (uint8_t))))
+    {
+        fprintf(stderr, "Failed to allocate buffer\n");
+        result = EXIT_FAILURE;
+    }
+    for (uint32_t index = 0; (result == EXIT_SUCCESS) && (index < sizeof (MAPPER) / sizeof (*MAPPER)); ++index)
+    {
+        if ((result = bench_mapper(&MAPPER[index])) != EXIT_SUCCESS)
+        {
+            fprintf(stderr, "%s\n", dmgl_error());
+        }
+    }
+    free(g_bench.context.ram.data);
+    free((uint8_t *)g_bench.context.rom.data);
+    return result;
+}
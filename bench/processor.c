@@ -0,0 +1,170 @@
+/*
+ * SPDX-FileCopyrightText: 2023 David Jolly <majestic53@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <bench.h>
+#include <processor.h>
+
+#define ITERATIONS (1 << 24)
+
+typedef struct
+{
+    uint16_t opcode;
+    uint8_t length;
+} bench_opcode_t;
+
+static const bench_opcode_t MIX[] =
+{
+    /* LOAD */
+    { 0x78, 1, }, { 0x47, 1, }, { 0x4F, 1, }, { 0x57, 1, }, { 0x5F, 1, }, { 0x7E, 1, }, { 0x77, 1, }, { 0x2A, 1, },
+    { 0x22, 1, }, { 0x1A, 1, }, { 0x12, 1, }, { 0x3E, 2, }, { 0x06, 2, }, { 0x0E, 2, }, { 0x21, 3, }, { 0x11, 3, },
+    { 0xE0, 2, }, { 0xF0, 2, }, { 0xEA, 3, }, { 0xFA, 3, },
+    /* ARITHMETIC/LOGIC */
+    { 0x04, 1, }, { 0x05, 1, }, { 0x0C, 1, }, { 0x0D, 1, }, { 0x3C, 1, }, { 0x3D, 1, }, { 0x23, 1, }, { 0x13, 1, },
+    { 0x0B, 1, }, { 0x80, 1, }, { 0x90, 1, }, { 0xA7, 1, }, { 0xAF, 1, }, { 0xB1, 1, }, { 0xB8, 1, }, { 0xFE, 2, },
+    { 0xE6, 2, }, { 0xC6, 2, }, { 0x19, 1, }, { 0x89, 1, }, { 0x99, 1, },
+    /* CONTROL */
+    { 0x18, 2, }, { 0x20, 2, }, { 0x28, 2, }, { 0x30, 2, }, { 0xC3, 3, }, { 0xCA, 3, }, { 0xCD, 3, }, { 0xC9, 1, },
+    { 0xC0, 1, }, { 0xC5, 1, }, { 0xC1, 1, }, { 0xE5, 1, }, { 0xE1, 1, }, { 0xDF, 1, }, { 0x00, 1, },
+};
+
+static const bench_opcode_t MIX_LOAD[] = /* REGISTER LOADS, WHICH LEAVE THE FLAGS ALONE */
+{
+    { 0x41, 1, }, { 0x4A, 1, }, { 0x53, 1, }, { 0x5C, 1, }, { 0x62, 1, }, { 0x6B, 1, }, { 0x47, 1, }, { 0x57, 1, },
+};
+
+static const bench_opcode_t MIX_ALU[] = /* REGISTER ALU OPERATIONS, WHICH DO ARITHMETIC AND SET EVERY FLAG (ADC/SBC ALSO READ F), SO THE DIFFERENCE ONLY BOUNDS THE FLAG COST */
+{
+    { 0x80, 1, }, { 0x91, 1, }, { 0xA2, 1, }, { 0xB3, 1, }, { 0x8C, 1, }, { 0x9D, 1, }, { 0xAB, 1, }, { 0xBA, 1, },
+};
+
+static const bench_opcode_t MIX_CB[] =
+{
+    { 0xCB37, 2, }, { 0xCB3F, 2, }, { 0xCB27, 2, }, { 0xCB11, 2, }, { 0xCB19, 2, }, { 0xCB47, 2, }, { 0xCB7E, 2, },
+    { 0xCB87, 2, }, { 0xCBC7, 2, }, { 0xCBFE, 2, }, { 0xCB46, 2, }, { 0xCB01, 2, },
+};
+
+static const uint8_t LOOP_COUNT[] = /* DEC B, JR NZ, THEN JR BACK ONCE B WRAPS */
+{
+    0x05, 0x20, 0xFD, 0x18, 0xFB,
+};
+
+static const uint8_t LOOP_COUNT_FLAGLESS[] = /* THE SAME LOOP WITH DEC BC, WHICH LEAVES THE FLAGS ALONE, SO JR NZ IS ALWAYS TAKEN */
+{
+    0x0B, 0x20, 0xFD, 0x18, 0xFB,
+};
+
+static const uint8_t LOOP_COPY[] = /* LD A,(HL+), LD (DE),A, INC DE, DEC C, JR NZ, THEN JR BACK ONCE C WRAPS */
+{
+    0x2A, 0x12, 0x13, 0x0D, 0x20, 0xFA, 0x18, 0xF8,
+};
+
+static const uint8_t LOOP_COPY_FLAGLESS[] = /* THE SAME LOOP WITH DEC BC */
+{
+    0x2A, 0x12, 0x13, 0x0B, 0x20, 0xFA, 0x18, 0xF8,
+};
+
+static struct
+{
+    uint8_t ram[0x10000];
+    dmgl_processor_t processor;
+    dmgl_telemetry_t telemetry;
+} g_bench = {};
+
+uint8_t dmgl_read(uint16_t address)
+{
+    return g_bench.ram[address];
+}
+
+void dmgl_write(uint16_t address, uint8_t value)
+{
+    /* WRITES ARE DISCARDED TO KEEP THE OPCODE STREAM FIXED */
+}
+
+void dmgl_interrupt(uint8_t interrupt)
+{
+    return;
+}
+
+uint8_t dmgl_peek(uint16_t address)
+{
+    return g_bench.ram[address];
+}
+
+void dmgl_trace(void)
+{
+    return;
+}
+
+static void bench_fill(const bench_opcode_t *const mix, uint32_t count, uint32_t seed)
+{
+    uint32_t address = 0;
+    while (address < sizeof (g_bench.ram))
+    {
+        const bench_opcode_t *opcode = &mix[bench_random(&seed) % count];
+        if ((address + opcode->length) > sizeof (g_bench.ram))
+        {
+            g_bench.ram[address++] = 0x00; /* NOP */
+            continue;
+        }
+        if (opcode->opcode > 0xFF)
+        {
+            g_bench.ram[address++] = opcode->opcode >> 8;
+            g_bench.ram[address++] = opcode->opcode;
+        }
+        else
+        {
+            g_bench.ram[address++] = opcode->opcode;
+            for (uint8_t index = 1; index < opcode->length; ++index)
+            {
+                g_bench.ram[address++] = bench_random(&seed);
+            }
+        }
+    }
+}
+
+static void bench_run(const char *const name)
+{
+    uint64_t cycles = 0, elapsed = 0;
+    memset(&g_bench.processor, 0, sizeof (g_bench.processor));
+    g_bench.processor.sp.word = 0xFFFE;
+    g_bench.processor.telemetry = &g_bench.telemetry;
+    cycles = bench_cycles();
+    elapsed = bench_clock();
+    for (uint32_t index = 0; index < ITERATIONS; ++index)
+    {
+        g_bench.processor.delay = 0;
+        g_bench.processor.fused.delay = 0; /* A FUSED PAIR COUNTS AS ONE DISPATCH */
+        dmgl_processor_clock(&g_bench.processor);
+    }
+    elapsed = bench_clock() - elapsed;
+    cycles = bench_cycles() - cycles;
+    bench_report(name, ITERATIONS, elapsed, cycles);
+}
+
+static void bench_dispatch(const char *const name, const bench_opcode_t *const mix, uint32_t count)
+{
+    bench_fill(mix, count, 0x2F6B1A3D);
+    bench_run(name);
+}
+
+static void bench_loop(const char *const name, const uint8_t *const loop, uint32_t length)
+{ /* A FIXED LOOP AT 0x0000, SO BRANCHES PREDICT THE WAY THEY DO IN A GAME */
+    memset(g_bench.ram, 0, sizeof (g_bench.ram));
+    memcpy(g_bench.ram, loop, length);
+    bench_run(name);
+}
+
+int main(void)
+{
+    bench_dispatch("processor/dispatch/mix", MIX, sizeof (MIX) / sizeof (*MIX));
+    bench_dispatch("processor/dispatch/cb", MIX_CB, sizeof (MIX_CB) / sizeof (*MIX_CB));
+    bench_dispatch("processor/dispatch/load", MIX_LOAD, sizeof (MIX_LOAD) / sizeof (*MIX_LOAD));
+    bench_dispatch("processor/dispatch/alu", MIX_ALU, sizeof (MIX_ALU) / sizeof (*MIX_ALU));
+    bench_loop("processor/loop/count", LOOP_COUNT, sizeof (LOOP_COUNT));
+    bench_loop("processor/loop/count-flagless", LOOP_COUNT_FLAGLESS, sizeof (LOOP_COUNT_FLAGLESS));
+    bench_loop("processor/loop/copy", LOOP_COPY, sizeof (LOOP_COPY));
+    bench_loop("processor/loop/copy-flagless", LOOP_COPY_FLAGLESS, sizeof (LOOP_COPY_FLAGLESS));
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,79 @@
+/*
+ * SPDX-FileCopyrightText: 2023 David Jolly <majestic53@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <bench.h>
+#include <video.h>
+
+#define ITERATIONS (1 << 16)
+
+static struct
+{
+    dmgl_video_t video;
+} g_bench = {};
+
+uint8_t dmgl_read(uint16_t address)
+{
+    return 0xFF;
+}
+
+void dmgl_interrupt(uint8_t interrupt)
+{
+    return;
+}
+
+static void bench_snapshot(uint8_t control)
+{
+    uint32_t seed = 0x51C0FFEE;
+    dmgl_video_uninitialize(&g_bench.video);
+    memset(&g_bench.video, 0, sizeof (g_bench.video));
+    dmgl_video_initialize(&g_bench.video);
+    dmgl_video_color(&g_bench.video);
+    for (uint32_t index = 0; index < sizeof (g_bench.video.ram->data); ++index)
+    {
+        g_bench.video.ram->data[index] = bench_random(&seed);
+    }
+    for (uint32_t index = 0; index < 40; ++index)
+    {
+        g_bench.video.object.ram[index].y = 16 + ((index * 4) % 144);
+        g_bench.video.object.ram[index].x = bench_random(&seed) % 168;
+        g_bench.video.object.ram[index].index = bench_random(&seed);
+        g_bench.video.object.ram[index].attribute.raw = bench_random(&seed) & 0xF0;
+    }
+    g_bench.video.background.palette.raw = 0xE4;
+    g_bench.video.object.palette[0].raw = 0xD2;
+    g_bench.video.object.palette[1].raw = 0xE4;
+    g_bench.video.window.x = 87;
+    g_bench.video.window.y = 72;
+    g_bench.video.control.raw = control;
+}
+
+static void bench_scanline(const char *const name, uint8_t control)
+{
+    uint64_t cycles = 0, elapsed = 0;
+    bench_snapshot(control);
+    cycles = bench_cycles();
+    elapsed = bench_clock();
+    for (uint32_t index = 0; index < ITERATIONS; ++index)
+    {
+        g_bench.video.line.y = index % 144;
+        g_bench.video.line.x = 80; /* TRANSFER */
+        dmgl_video_clock(&g_bench.video);
+        g_bench.video.line.x = 260; /* HBLANK */
+        dmgl_video_clock(&g_bench.video);
+    }
+    elapsed = bench_clock() - elapsed;
+    cycles = bench_cycles() - cycles;
+    bench_report(name, ITERATIONS, elapsed, cycles);
+}
+
+int main(void)
+{
+    bench_scanline("video/scanline/background", 0x91);
+    bench_scanline("video/scanline/window", 0xB1);
+    bench_scanline("video/scanline/objects", 0x82);
+    bench_scanline("video/scanline/objects-tall", 0x86);
+    bench_scanline("video/scanline/all", 0xB3);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,351 @@
+/*
+ * SPDX-FileCopyrightText: 2023 David Jolly <majestic53@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <dmgl.h>
+
+#define CHECK_FRAMES 600
+#define CHECK_THREADS 4
+
+typedef struct
+{
+    char name[256];
+    char digest[2][4096]; /* GOLDEN, CURRENT */
+    char trace[2][4096];
+    FILE *file;
+    dmgl_t context;
+    dmgl_instance_t *instance;
+} check_rom_t;
+
+static const struct option OPTION[] =
+{
+    { "frames", required_argument, NULL, 'f', },
+    { "help", no_argument, NULL, 'h', },
+    { "record", no_argument, NULL, 'r', },
+    { "threads", required_argument, NULL, 't', },
+    { NULL, 0, NULL, 0, },
+};
+
+static struct
+{
+    bool record;
+    uint32_t count;
+    uint32_t frames;
+    uint32_t threads;
+    check_rom_t *rom;
+} g_check = { false, 0, CHECK_FRAMES, CHECK_THREADS, NULL, };
+
+static bool check_equal(const dmgl_trace_t *const golden, const dmgl_trace_t *const current)
+{
+    return (golden->cycle == current->cycle) && (golden->bank == current->bank) && (golden->pc == current->pc)
+        && (golden->af == current->af) && (golden->bc == current->bc) && (golden->de == current->de) && (golden->hl == current->hl)
+        && (golden->sp == current->sp) && !memcmp(golden->opcode, current->opcode, sizeof (golden->opcode))
+        && (golden->interrupt.enabled == current->interrupt.enabled) && (golden->interrupt.enable == current->interrupt.enable)
+        && (golden->interrupt.flag == current->interrupt.flag);
+}
+
+static void check_format(char *const text, size_t length, const dmgl_trace_t *const trace)
+{
+    char instruction[32] = {};
+    dmgl_disassemble(instruction, sizeof (instruction), trace->pc, trace->opcode);
+    snprintf(text, length, "%012llu %02X:%04X %-16s AF=%04X BC=%04X DE=%04X HL=%04X SP=%04X IME=%u IE=%02X IF=%02X",
+        (unsigned long long)trace->cycle, trace->bank, trace->pc, instruction, trace->af, trace->bc, trace->de, trace->hl, trace->sp,
+        trace->interrupt.enabled, trace->interrupt.enable, trace->interrupt.flag);
+}
+
+static bool check_movie(check_rom_t *const rom, const char *const path)
+{
+    FILE *file = NULL;
+    char movie[4096] = {};
+    snprintf(movie, sizeof (movie), "%s.mov", path);
+    if (!(file = fopen(movie, "rb")))
+    { /* ROMS WITHOUT A MOVIE RUN WITHOUT INPUT */
+        return true;
+    }
+    fseek(file, 0, SEEK_END);
+    rom->context.movie.length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (!(rom->context.movie.data = malloc(rom->context.movie.length))
+            || (fread(rom->context.movie.data, sizeof (uint8_t), rom->context.movie.length, file) != rom->context.movie.length))
+    {
+        fprintf(stderr, "Failed to read movie -- %s\n", movie);
+        fclose(file);
+        return false;
+    }
+    fclose(file);
+    return true;
+}
+
+static bool check_open(check_rom_t *const rom, const char *const golden, const char *const path)
+{
+    const char *name = strrchr(path, '/') ? (strrchr(path, '/') + 1) : path;
+    snprintf(rom->name, sizeof (rom->name), "%s", name);
+    snprintf(rom->digest[0], sizeof (rom->digest[0]), "%s/%s.frames", golden, rom->name);
+    snprintf(rom->digest[1], sizeof (rom->digest[1]), "%s/%s-check.frames", golden, rom->name);
+    snprintf(rom->trace[0], sizeof (rom->trace[0]), "%s/%s.dmt", golden, rom->name);
+    snprintf(rom->trace[1], sizeof (rom->trace[1]), "%s/%s-check.dmt", golden, rom->name);
+    if (dmgl_rom_map(path, &rom->context.rom.data, &rom->context.rom.length) != EXIT_SUCCESS)
+    {
+        fprintf(stderr, "%s\n", dmgl_error());
+        return false;
+    }
+    if (!check_movie(rom, path))
+    {
+        return false;
+    }
+    rom->context.bootrom.skip = true;
+    rom->context.ram.length = 17 * 0x2000; /* BLANK SAVE RAM, SO EVERY RUN STARTS THE SAME */
+    if (!(rom->context.ram.data = calloc(rom->context.ram.length, sizeof (uint8_t))))
+    {
+        fprintf(stderr, "Failed to allocate ram -- %u bytes\n", rom->context.ram.length);
+        return false;
+    }
+    rom->context.trace.path = rom->trace[g_check.record ? 0 : 1];
+    if (!(rom->file = fopen(rom->digest[g_check.record ? 0 : 1], "w")))
+    {
+        fprintf(stderr, "Failed to open digest -- %s\n", rom->digest[g_check.record ? 0 : 1]);
+        return false;
+    }
+    if (!(rom->instance = dmgl_create(&rom->context)))
+    {
+        fprintf(stderr, "%s\n", dmgl_error());
+        return false;
+    }
+    return true;
+}
+
+static void check_close(check_rom_t *const rom)
+{
+    dmgl_destroy(rom->instance);
+    rom->instance = NULL;
+    if (rom->file)
+    {
+        fclose(rom->file);
+        rom->file = NULL;
+    }
+    if (rom->context.rom.data)
+    {
+        dmgl_rom_unmap(rom->context.rom.data);
+        rom->context.rom.data = NULL;
+    }
+    free(rom->context.movie.data);
+    rom->context.movie.data = NULL;
+    free(rom->context.ram.data);
+    rom->context.ram.data = NULL;
+}
+
+static bool check_digest(check_rom_t *const rom, uint32_t frame)
+{
+    dmgl_digest_t digest = {};
+    if (dmgl_digest(rom->instance, &digest) != EXIT_SUCCESS)
+    {
+        fprintf(stderr, "%s\n", dmgl_error());
+        return false;
+    }
+    fprintf(rom->file, "%u %llu %016llX %016llX %016llX\n", frame, (unsigned long long)digest.cycle,
+        (unsigned long long)digest.wram, (unsigned long long)digest.vram, (unsigned long long)digest.color);
+    return true;
+}
+
+static bool check_run(void)
+{
+    bool result = true;
+    uint8_t *action = NULL;
+    dmgl_instance_t **instance = NULL;
+    dmgl_batch_t batch = { .frames = 1, .threads = g_check.threads, };
+    if (!(action = calloc(g_check.count, sizeof (*action))) || !(instance = calloc(g_check.count, sizeof (*instance))))
+    {
+        fprintf(stderr, "Failed to allocate batch -- %u roms\n", g_check.count);
+        result = false;
+    }
+    for (uint32_t index = 0; result && (index < g_check.count); ++index)
+    {
+        instance[index] = g_check.rom[index].instance;
+        result = check_digest(&g_check.rom[index], 0);
+    }
+    for (uint32_t frame = 1; result && (frame <= g_check.frames); ++frame)
+    { /* EVERY ROM ADVANCES ONE FRAME PER BATCH, SO DIGESTS ARE TAKEN AT THE SAME POINT IN EACH BUILD */
+        if (dmgl_batch(instance, action, g_check.count, &batch) != EXIT_SUCCESS)
+        {
+            fprintf(stderr, "%s\n", dmgl_error());
+            result = false;
+        }
+        for (uint32_t index = 0; result && (index < g_check.count); ++index)
+        {
+            result = check_digest(&g_check.rom[index], frame);
+        }
+    }
+    free(instance);
+    free(action);
+    return result;
+}
+
+static bool check_frames(const check_rom_t *const rom, uint32_t *frame)
+{
+    bool result = true;
+    FILE *file[2] = {};
+    char line[2][256] = {};
+    if (!(file[0] = fopen(rom->digest[0], "r")) || !(file[1] = fopen(rom->digest[1], "r")))
+    {
+        fprintf(stderr, "Failed to open digest -- %s\n", file[0] ? rom->digest[1] : rom->digest[0]);
+        *frame = 0;
+        result = false;
+    }
+    while (result)
+    {
+        bool golden = fgets(line[0], sizeof (line[0]), file[0]), current = fgets(line[1], sizeof (line[1]), file[1]);
+        if (!golden && !current)
+        {
+            break;
+        }
+        if ((golden != current) || strcmp(line[0], line[1]))
+        {
+            *frame = strtoul(golden ? line[0] : line[1], NULL, 10);
+            result = false;
+        }
+    }
+    for (uint8_t index = 0; index < 2; ++index)
+    {
+        if (file[index])
+        {
+            fclose(file[index]);
+        }
+    }
+    return result;
+}
+
+static bool check_trace(const check_rom_t *const rom, uint64_t *count)
+{
+    bool result = true;
+    dmgl_trace_t previous = {};
+    dmgl_trace_reader_t *reader[2] = {};
+    if (!(reader[0] = dmgl_trace_open(rom->trace[0])) || !(reader[1] = dmgl_trace_open(rom->trace[1])))
+    {
+        fprintf(stderr, "%s\n", dmgl_error());
+        result = false;
+    }
+    for (*count = 0; result; ++*count)
+    {
+        char text[3][128] = {};
+        dmgl_trace_t trace[2] = {};
+        uint32_t golden = dmgl_trace_next(reader[0], &trace[0]), current = dmgl_trace_next(reader[1], &trace[1]);
+        if (!golden && !current)
+        {
+            break;
+        }
+        if ((golden != current) || !check_equal(&trace[0], &trace[1]))
+        { /* THE INSTRUCTION BEFORE (WHICH BOTH RAN FROM THE SAME STATE) IS USUALLY THE ONE THAT DIVERGED */
+            check_format(text[0], sizeof (text[0]), &trace[0]);
+            check_format(text[1], sizeof (text[1]), &trace[1]);
+            check_format(text[2], sizeof (text[2]), &previous);
+            fprintf(stdout, "FAIL %s: instruction %llu diverges\n  after   %s\n  golden  %s\n  current %s\n", rom->name,
+                (unsigned long long)*count, *count ? text[2] : "(start of trace)", golden ? text[0] : "(end of trace)",
+                current ? text[1] : "(end of trace)");
+            result = false;
+        }
+        previous = trace[0];
+    }
+    for (uint8_t index = 0; index < 2; ++index)
+    {
+        if (dmgl_trace_close(reader[index]) != EXIT_SUCCESS)
+        {
+            fprintf(stderr, "%s\n", dmgl_error());
+            result = false;
+        }
+    }
+    return result;
+}
+
+static bool check_compare(const check_rom_t *const rom)
+{
+    uint32_t frame = 0;
+    uint64_t count = 0;
+    if (!check_trace(rom, &count))
+    { /* THE FIRST DIVERGING INSTRUCTION EXPLAINS ANY LATER FRAME MISMATCH */
+        return false;
+    }
+    if (!check_frames(rom, &frame))
+    {
+        fprintf(stdout, "FAIL %s: frame %u digest diverges (registers match)\n", rom->name, frame);
+        return false;
+    }
+    fprintf(stdout, "PASS %s: %llu instructions, %u frames\n", rom->name, (unsigned long long)count, g_check.frames);
+    unlink(rom->digest[1]);
+    unlink(rom->trace[1]);
+    return true;
+}
+
+static void usage(void)
+{
+    fprintf(stdout, "Usage: dmgl-check [-f FRAMES] [-r] [-t THREADS] GOLDEN ROM...\n");
+}
+
+int main(int argc, char *argv[])
+{
+    bool running = false;
+    int option = 0, result = EXIT_SUCCESS;
+    while ((option = getopt_long(argc, argv, "f:hrt:", OPTION, NULL)) != -1)
+    {
+        switch (option)
+        {
+            case 'f': /* FRAMES */
+                g_check.frames = strtoul(optarg, NULL, 10);
+                break;
+            case 'h': /* HELP */
+                usage();
+                return EXIT_SUCCESS;
+            case 'r': /* RECORD */
+                g_check.record = true;
+                break;
+            case 't': /* THREADS */
+                g_check.threads = strtoul(optarg, NULL, 10);
+                break;
+            case '?':
+            default:
+                return EXIT_FAILURE;
+        }
+    }
+    if ((argc - optind) < 2)
+    {
+        usage();
+        return EXIT_FAILURE;
+    }
+    g_check.count = argc - optind - 1;
+    if (!(g_check.rom = calloc(g_check.count, sizeof (*g_check.rom))))
+    {
+        fprintf(stderr, "Failed to allocate roms -- %u roms\n", g_check.count);
+        return EXIT_FAILURE;
+    }
+    for (uint32_t index = 0; (result == EXIT_SUCCESS) && (index < g_check.count); ++index)
+    {
+        result = check_open(&g_check.rom[index], argv[optind], argv[optind + 1 + index]) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    if ((result == EXIT_SUCCESS) && !check_run())
+    {
+        result = EXIT_FAILURE;
+    }
+    running = (result == EXIT_SUCCESS);
+    for (uint32_t index = 0; index < g_check.count; ++index)
+    { /* TRACES ARE ONLY COMPLETE ONCE THEIR INSTANCE IS DESTROYED */
+        check_close(&g_check.rom[index]);
+    }
+    for (uint32_t index = 0; running && (index < g_check.count); ++index)
+    { /* EVERY ROM IS REPORTED, EVEN AFTER ONE FAILS */
+        if (g_check.record)
+        {
+            fprintf(stdout, "RECORD %s: %u frames\n", g_check.rom[index].name, g_check.frames);
+        }
+        else if (!check_compare(&g_check.rom[index]))
+        {
+            result = EXIT_FAILURE;
+        }
+    }
+    free(g_check.rom);
+    return result;
+}
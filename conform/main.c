@@ -0,0 +1,384 @@
+/*
+ * SPDX-FileCopyrightText: 2023 David Jolly <majestic53@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <dirent.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include <dmgl.h>
+
+#define CONFORM_CYCLES (120 * 4194304ULL) /* TWO EMULATED MINUTES */
+#define CONFORM_SERIAL 4096
+#define CONFORM_SLICE 4194304 /* CYCLES BETWEEN SERIAL CHECKS */
+
+#define CONFORM_ERROR 0
+#define CONFORM_FAIL 1
+#define CONFORM_PASS 2
+#define CONFORM_TIMEOUT 3
+
+typedef struct
+{
+    char *path;
+    uint8_t result;
+    const char *method;
+    uint64_t cycles;
+    double seconds;
+    struct
+    {
+        uint8_t bits;
+        uint8_t value;
+        uint32_t length;
+        char data[CONFORM_SERIAL + 1];
+    } serial;
+} conform_rom_t;
+
+static const char *RESULT[] =
+{
+    "ERROR", "FAIL", "PASS", "TIMEOUT",
+};
+
+static const uint8_t FIBONACCI[] =
+{
+    3, 5, 8, 13, 21, 34, /* B, C, D, E, H, L */
+};
+
+static const struct option OPTION[] =
+{
+    { "cycles", required_argument, NULL, 'c', },
+    { "help", no_argument, NULL, 'h', },
+    { "threads", required_argument, NULL, 't', },
+    { NULL, 0, NULL, 0, },
+};
+
+static struct
+{
+    uint32_t capacity;
+    uint32_t count;
+    uint64_t cycles;
+    uint32_t next;
+    uint32_t threads;
+    conform_rom_t *rom;
+} g_conform = { 0, 0, CONFORM_CYCLES, 0, 0, NULL, };
+
+static __thread conform_rom_t *g_rom = NULL;
+
+static uint8_t conform_output(uint8_t value)
+{ /* BITS ARRIVE MSB FIRST, ONE PER SERIAL CLOCK, WITH NOTHING ON THE OTHER END OF THE LINK */
+    g_rom->serial.value = (g_rom->serial.value << 1) | (value & 1);
+    if (++g_rom->serial.bits == 8)
+    {
+        if (g_rom->serial.length < CONFORM_SERIAL)
+        {
+            g_rom->serial.data[g_rom->serial.length++] = g_rom->serial.value;
+        }
+        g_rom->serial.bits = 0;
+    }
+    return 1;
+}
+
+static bool conform_serial(conform_rom_t *const rom, bool done)
+{
+    const char *found = NULL;
+    for (uint32_t offset = 0; (offset + sizeof (FIBONACCI)) <= rom->serial.length; ++offset)
+    { /* MOONEYE-STYLE SUITES ALSO SEND THEIR RESULT REGISTERS OVER SERIAL */
+        if (!memcmp(rom->serial.data + offset, FIBONACCI, sizeof (FIBONACCI)))
+        {
+            rom->result = CONFORM_PASS;
+            return true;
+        }
+        if (!memcmp(rom->serial.data + offset, "BBBBBB", sizeof (FIBONACCI)))
+        {
+            rom->result = CONFORM_FAIL;
+            return true;
+        }
+    }
+    if ((found = strstr(rom->serial.data, "Passed")) || (found = strstr(rom->serial.data, "Failed")))
+    { /* BLARGG-STYLE SUITES PRINT A LINE, SO WAIT FOR IT TO END BEFORE REPORTING IT */
+        if (done || strchr(found, '\n'))
+        {
+            rom->result = (found[0] == 'P') ? CONFORM_PASS : CONFORM_FAIL;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool conform_registers(conform_rom_t *const rom, dmgl_instance_t *const instance)
+{
+    dmgl_trace_t trace = {};
+    uint8_t value[6] = {};
+    if (dmgl_inspect(instance, &trace) != EXIT_SUCCESS)
+    {
+        return false;
+    }
+    value[0] = trace.bc >> 8;
+    value[1] = trace.bc;
+    value[2] = trace.de >> 8;
+    value[3] = trace.de;
+    value[4] = trace.hl >> 8;
+    value[5] = trace.hl;
+    if (!memcmp(value, FIBONACCI, sizeof (value)))
+    {
+        rom->result = CONFORM_PASS;
+        return true;
+    }
+    if (!memcmp(value, "BBBBBB", sizeof (value)))
+    {
+        rom->result = CONFORM_FAIL;
+        return true;
+    }
+    return false;
+}
+
+static void conform_rom(conform_rom_t *const rom)
+{
+    dmgl_stop_t stop = {};
+    dmgl_instance_t *instance = NULL;
+    struct timespec begin = {}, end = {};
+    dmgl_t context = { .bootrom.skip = true, .client.output = conform_output, };
+    const dmgl_break_t debug = { .type = DMGL_BREAK_OPCODE, .compare = { DMGL_COMPARE_EQUAL, 0xFF, 0x40, }, }; /* LD B,B */
+    g_rom = rom;
+    rom->result = CONFORM_ERROR;
+    rom->method = "-";
+    if (dmgl_rom_map(rom->path, &context.rom.data, &context.rom.length) != EXIT_SUCCESS)
+    {
+        snprintf(rom->serial.data, sizeof (rom->serial.data), "%s", dmgl_error());
+        return;
+    }
+    context.ram.length = 17 * 0x2000;
+    if (!(context.ram.data = calloc(context.ram.length, sizeof (uint8_t))))
+    {
+        snprintf(rom->serial.data, sizeof (rom->serial.data), "Failed to allocate ram -- %u bytes", context.ram.length);
+    }
+    else if (!(instance = dmgl_create(&context)) || (dmgl_break_add(instance, &debug) != EXIT_SUCCESS))
+    {
+        snprintf(rom->serial.data, sizeof (rom->serial.data), "%s", dmgl_error());
+    }
+    else
+    {
+        rom->result = CONFORM_TIMEOUT;
+        clock_gettime(CLOCK_MONOTONIC, &begin);
+        while (rom->cycles < g_conform.cycles)
+        {
+            uint64_t cycles = g_conform.cycles - rom->cycles;
+            dmgl_run(instance, (cycles < CONFORM_SLICE) ? cycles : CONFORM_SLICE, 0, &stop);
+            rom->cycles += stop.cycles;
+            if ((stop.reason == DMGL_STOP_BREAK) && conform_registers(rom, instance))
+            {
+                rom->method = "registers";
+                break;
+            }
+            if (conform_serial(rom, false))
+            {
+                rom->method = "serial";
+                break;
+            }
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        rom->seconds = (end.tv_sec - begin.tv_sec) + ((end.tv_nsec - begin.tv_nsec) / 1e9);
+        if ((rom->result == CONFORM_TIMEOUT) && conform_serial(rom, true))
+        { /* A RESULT LINE CUT OFF BY THE BUDGET STILL COUNTS */
+            rom->method = "serial";
+        }
+    }
+    dmgl_destroy(instance);
+    free(context.ram.data);
+    dmgl_rom_unmap(context.rom.data);
+}
+
+static void *conform_worker(void *argument)
+{
+    uint32_t index = 0;
+    while ((index = __atomic_fetch_add(&g_conform.next, 1, __ATOMIC_RELAXED)) < g_conform.count)
+    {
+        conform_rom(&g_conform.rom[index]);
+    }
+    return NULL;
+}
+
+static int conform_add(const char *const path)
+{
+    if (g_conform.count == g_conform.capacity)
+    {
+        conform_rom_t *rom = NULL;
+        uint32_t capacity = g_conform.capacity ? (2 * g_conform.capacity) : 64;
+        if (!(rom = realloc(g_conform.rom, capacity * sizeof (*rom))))
+        {
+            fprintf(stderr, "Failed to allocate roms -- %u roms\n", capacity);
+            return EXIT_FAILURE;
+        }
+        g_conform.rom = rom;
+        g_conform.capacity = capacity;
+    }
+    memset(&g_conform.rom[g_conform.count], 0, sizeof (*g_conform.rom));
+    if (!(g_conform.rom[g_conform.count].path = strdup(path)))
+    {
+        fprintf(stderr, "Failed to allocate path -- %s\n", path);
+        return EXIT_FAILURE;
+    }
+    ++g_conform.count;
+    return EXIT_SUCCESS;
+}
+
+static int conform_collect(const char *const path)
+{
+    DIR *directory = NULL;
+    struct dirent *entry = NULL;
+    struct stat status = {};
+    int result = EXIT_SUCCESS;
+    if (stat(path, &status))
+    {
+        fprintf(stderr, "Failed to find path -- %s\n", path);
+        return EXIT_FAILURE;
+    }
+    if (!S_ISDIR(status.st_mode))
+    {
+        return conform_add(path);
+    }
+    if (!(directory = opendir(path)))
+    {
+        fprintf(stderr, "Failed to open directory -- %s\n", path);
+        return EXIT_FAILURE;
+    }
+    while ((result == EXIT_SUCCESS) && (entry = readdir(directory)))
+    { /* DIRECTORIES ARE SEARCHED FOR .gb FILES, SO A SUITE CAN BE PASSED WHOLE */
+        char child[4096] = {};
+        size_t length = strlen(entry->d_name);
+        if (entry->d_name[0] == '.')
+        {
+            continue;
+        }
+        snprintf(child, sizeof (child), "%s/%s", path, entry->d_name);
+        if (!stat(child, &status) && (S_ISDIR(status.st_mode) || ((length > 3) && !strcmp(entry->d_name + length - 3, ".gb"))))
+        {
+            result = conform_collect(child);
+        }
+    }
+    closedir(directory);
+    return result;
+}
+
+static int conform_comparator(const void *first, const void *second)
+{
+    return strcmp(((const conform_rom_t *)first)->path, ((const conform_rom_t *)second)->path);
+}
+
+static int conform_report(void)
+{
+    double seconds = 0;
+    uint64_t cycles = 0;
+    uint32_t count[4] = {};
+    fprintf(stdout, "%-8s %-48s %-10s %14s %10s %10s\n", "RESULT", "ROM", "METHOD", "CYCLES", "SECONDS", "MHZ");
+    for (uint32_t index = 0; index < g_conform.count; ++index)
+    {
+        const conform_rom_t *const rom = &g_conform.rom[index];
+        fprintf(stdout, "%-8s %-48s %-10s %14llu %10.3f %10.2f\n", RESULT[rom->result], rom->path, rom->method,
+            (unsigned long long)rom->cycles, rom->seconds, rom->seconds ? ((rom->cycles / rom->seconds) / 1e6) : 0);
+        if ((rom->result == CONFORM_ERROR) || ((rom->result == CONFORM_FAIL) && (rom->method[0] == 's')))
+        { /* THE LAST LINE A FAILING SUITE PRINTED USUALLY NAMES THE FAILING TEST */
+            const char *line = rom->serial.data + strlen(rom->serial.data);
+            while ((line > rom->serial.data) && ((line[-1] == '\n') || (line[-1] == ' ')))
+            {
+                --line;
+            }
+            while ((line > rom->serial.data) && (line[-1] != '\n'))
+            {
+                --line;
+            }
+            fprintf(stdout, "         %.*s\n", (int)strcspn(line, "\n"), line);
+        }
+        cycles += rom->cycles;
+        seconds += rom->seconds;
+        ++count[rom->result];
+    }
+    fprintf(stdout, "%u passed, %u failed, %u timed out, %u errors, %.2f MHz per thread\n", count[CONFORM_PASS], count[CONFORM_FAIL],
+        count[CONFORM_TIMEOUT], count[CONFORM_ERROR], seconds ? ((cycles / seconds) / 1e6) : 0);
+    return (count[CONFORM_PASS] == g_conform.count) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static void usage(void)
+{
+    fprintf(stdout, "Usage: dmgl-conform [-c CYCLES] [-t THREADS] PATH...\n");
+}
+
+int main(int argc, char *argv[])
+{
+    pthread_t *thread = NULL;
+    int option = 0, result = EXIT_SUCCESS;
+    while ((option = getopt_long(argc, argv, "c:ht:", OPTION, NULL)) != -1)
+    {
+        switch (option)
+        {
+            case 'c': /* CYCLES */
+                g_conform.cycles = strtoull(optarg, NULL, 10);
+                break;
+            case 'h': /* HELP */
+                usage();
+                return EXIT_SUCCESS;
+            case 't': /* THREADS */
+                g_conform.threads = strtoul(optarg, NULL, 10);
+                break;
+            case '?':
+            default:
+                return EXIT_FAILURE;
+        }
+    }
+    if (optind == argc)
+    {
+        usage();
+        return EXIT_FAILURE;
+    }
+    for (option = optind; (result == EXIT_SUCCESS) && (option < argc); ++option)
+    {
+        result = conform_collect(argv[option]);
+    }
+    if ((result == EXIT_SUCCESS) && g_conform.count)
+    {
+        if (!g_conform.threads)
+        { /* ONE THREAD PER CORE BY DEFAULT */
+            long cores = sysconf(_SC_NPROCESSORS_ONLN);
+            g_conform.threads = (cores > 0) ? cores : 1;
+        }
+        if (g_conform.threads > g_conform.count)
+        {
+            g_conform.threads = g_conform.count;
+        }
+        qsort(g_conform.rom, g_conform.count, sizeof (*g_conform.rom), conform_comparator);
+        if (!(thread = calloc(g_conform.threads, sizeof (*thread))))
+        {
+            fprintf(stderr, "Failed to allocate threads -- %u threads\n", g_conform.threads);
+            result = EXIT_FAILURE;
+        }
+        for (uint32_t index = 1; (result == EXIT_SUCCESS) && (index < g_conform.threads); ++index)
+        {
+            if (pthread_create(&thread[index], NULL, conform_worker, NULL))
+            {
+                g_conform.threads = index;
+                break;
+            }
+        }
+        if (result == EXIT_SUCCESS)
+        { /* THE CALLING THREAD WORKS TOO */
+            conform_worker(NULL);
+            for (uint32_t index = 1; index < g_conform.threads; ++index)
+            {
+                pthread_join(thread[index], NULL);
+            }
+            result = conform_report();
+        }
+        free(thread);
+    }
+    for (uint32_t index = 0; index < g_conform.count; ++index)
+    {
+        free(g_conform.rom[index].path);
+    }
+    free(g_conform.rom);
+    return result;
+}
@@ -11,6 +11,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <dmgl.h>
 
 #define DMGL_MAJOR 0
@@ -20,6 +21,127 @@
 #define DMGL_ERROR(_FORMAT_, ...) \
     dmgl_error_set(__FILE__, __LINE__, _FORMAT_, ##__VA_ARGS__)
 
+#define DMGL_HASH 0xCBF29CE484222325
+
+#define DMGL_HEATMAP_READ 0
+#define DMGL_HEATMAP_WRITE 1
+#define DMGL_HEATMAP_EXECUTE 2
+
+#define DMGL_STATE 2
+
+typedef struct dmgl_coverage_s dmgl_coverage_t;
+
+typedef struct dmgl_heatmap_s dmgl_heatmap_t;
+
+typedef struct
+{
+    bool cycle;
+    bool playing;
+    bool recording;
+    bool skip;
+    uint8_t state;
+    uint32_t capacity;
+    uint32_t count;
+    uint32_t frame;
+    uint32_t frames;
+    uint32_t offset;
+    uint64_t next;
+    dmgl_t *context;
+} dmgl_movie_t;
+
+typedef struct
+{
+    uint32_t count;
+    uint8_t data[0x2000];
+} dmgl_page_t;
+
+typedef struct
+{
+    bool enabled;
+    bool valid;
+    uint8_t *data;
+    uint8_t *delta;
+    uint8_t *state[2];
+    uint32_t capacity;
+    uint32_t count;
+    uint32_t frame;
+    uint32_t head;
+    uint32_t interval;
+    uint32_t length;
+    uint32_t tail;
+    uint32_t used;
+} dmgl_rewind_t;
+
+typedef struct dmgl_sampler_s dmgl_sampler_t;
+
+typedef struct
+{
+    uint8_t *data;
+    uint32_t length;
+    uint32_t offset;
+    bool overflow;
+} dmgl_state_t;
+
+typedef struct dmgl_tracer_s dmgl_tracer_t;
+
+void dmgl_batch_run(uint32_t count, uint32_t threads, void (*function)(uint32_t index, void *argument), void *argument);
+int dmgl_cache_read(const char *const prefix, uint16_t checksum, uint64_t ram);
+int dmgl_cache_write(const char *const prefix, uint16_t checksum, uint64_t ram);
+dmgl_coverage_t *dmgl_coverage_create(const char *const path, uint16_t checksum, uint32_t rom);
+void dmgl_coverage_destroy(dmgl_coverage_t *const coverage);
+void dmgl_coverage_mark(dmgl_coverage_t *const coverage, uint8_t type, uint16_t bank, uint16_t address);
+uint8_t dmgl_coverage_test(const dmgl_coverage_t *const coverage, uint16_t bank, uint16_t address);
+int dmgl_coverage_write(const dmgl_coverage_t *const coverage, const char *const path);
 int dmgl_error_set(const char *const file, uint32_t line, const char *const format, ...);
+uint64_t dmgl_hash(uint64_t hash, const uint8_t *const data, uint32_t length);
+void dmgl_heatmap_access(dmgl_heatmap_t *const heatmap, uint8_t type, uint16_t bank, uint16_t address);
+dmgl_heatmap_t *dmgl_heatmap_create(uint32_t rom, uint32_t ram);
+void dmgl_heatmap_destroy(dmgl_heatmap_t *const heatmap);
+void dmgl_heatmap_mapper(dmgl_heatmap_t *const heatmap, uint16_t address);
+void dmgl_heatmap_select(dmgl_heatmap_t *const heatmap, uint16_t address, uint16_t bank);
+int dmgl_heatmap_write(const dmgl_heatmap_t *const heatmap, const char *const path);
+const char *dmgl_mnemonic(uint16_t opcode);
+void dmgl_movie_cycle(dmgl_movie_t *const movie, uint64_t cycle, bool (*state)[8]);
+bool dmgl_movie_frame(dmgl_movie_t *const movie, uint64_t cycle, bool (*state)[8]);
+int dmgl_movie_initialize(dmgl_movie_t *const movie, dmgl_t *const context, uint64_t rom, uint64_t ram);
+void dmgl_movie_uninitialize(dmgl_movie_t *const movie);
+dmgl_page_t *dmgl_page_allocate(uint8_t value);
+uint8_t *dmgl_page_copy(dmgl_page_t **page);
+void dmgl_page_free(dmgl_page_t *page);
+dmgl_page_t *dmgl_page_share(dmgl_page_t *page);
+uint32_t dmgl_rewind_available(const dmgl_rewind_t *const rewind, uint32_t frame);
+int dmgl_rewind_initialize(dmgl_rewind_t *const rewind, dmgl_t *const context, uint32_t length);
+uint8_t *dmgl_rewind_pending(dmgl_rewind_t *const rewind, uint32_t frame);
+uint8_t *dmgl_rewind_pop(dmgl_rewind_t *const rewind, uint32_t frame);
+void dmgl_rewind_push(dmgl_rewind_t *const rewind, uint32_t frame);
+void dmgl_rewind_reset(dmgl_rewind_t *const rewind);
+void dmgl_rewind_uninitialize(dmgl_rewind_t *const rewind);
+uint64_t dmgl_rom_hash(const uint8_t *const data, uint32_t length);
+void dmgl_sampler_add(dmgl_sampler_t *const sampler, const uint32_t *const frame, uint32_t depth, uint32_t location, uint32_t cycles);
+dmgl_sampler_t *dmgl_sampler_create(const char *const symbols);
+void dmgl_sampler_destroy(dmgl_sampler_t *const sampler);
+int dmgl_sampler_write(const dmgl_sampler_t *const sampler, const char *const path);
+void dmgl_save_sync(const uint8_t *const data);
+void dmgl_state_read(dmgl_state_t *const state, void *const data, uint32_t length);
+uint8_t dmgl_state_read_8(dmgl_state_t *const state);
+uint16_t dmgl_state_read_16(dmgl_state_t *const state);
+uint32_t dmgl_state_read_32(dmgl_state_t *const state);
+uint64_t dmgl_state_read_64(dmgl_state_t *const state);
+float dmgl_state_read_float(dmgl_state_t *const state);
+void dmgl_state_skip(dmgl_state_t *const state, uint32_t length);
+void dmgl_state_write(dmgl_state_t *const state, const void *const data, uint32_t length);
+void dmgl_state_write_8(dmgl_state_t *const state, uint8_t value);
+void dmgl_state_write_16(dmgl_state_t *const state, uint16_t value);
+void dmgl_state_write_32(dmgl_state_t *const state, uint32_t value);
+void dmgl_state_write_64(dmgl_state_t *const state, uint64_t value);
+void dmgl_state_write_float(dmgl_state_t *const state, float value);
+dmgl_tracer_t *dmgl_tracer_create(const char *const path);
+int dmgl_tracer_destroy(dmgl_tracer_t *const tracer);
+void dmgl_tracer_push(dmgl_tracer_t *const tracer, const dmgl_trace_t *const trace);
+
+static inline uint8_t *dmgl_page_write(dmgl_page_t **page)
+{ /* COPY-ON-WRITE: SHARED PAGES ARE COPIED BEFORE THEIR FIRST WRITE, ACQUIRING THE LAST SHARER'S RELEASE */
+    return (__atomic_load_n(&(*page)->count, __ATOMIC_ACQUIRE) == 1) ? (*page)->data : dmgl_page_copy(page);
+}
 
 #endif /* DMGL_COMMON_H_ */
@@ -0,0 +1,104 @@
+/*
+ * SPDX-FileCopyrightText: 2023 David Jolly <majestic53@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <pthread.h>
+#include <common.h>
+
+static struct
+{
+    bool busy;
+    pthread_cond_t done;
+    pthread_cond_t wake;
+    pthread_mutex_t lock;
+    uint32_t active;
+    uint32_t count;
+    uint32_t helpers;
+    uint32_t next;
+    uint32_t threads;
+    uint64_t generation;
+    void (*function)(uint32_t index, void *argument);
+    void *argument;
+} g_batch = { false, PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER, PTHREAD_MUTEX_INITIALIZER, };
+
+static void dmgl_batch_drain(void)
+{
+    uint32_t index = 0;
+    while ((index = __atomic_fetch_add(&g_batch.next, 1, __ATOMIC_RELAXED)) < g_batch.count)
+    {
+        g_batch.function(index, g_batch.argument);
+    }
+}
+
+static void *dmgl_batch_worker(void *argument)
+{
+    uint64_t generation = 0;
+    uint32_t id = (uintptr_t)argument;
+    pthread_mutex_lock(&g_batch.lock);
+    for (;;)
+    {
+        while (g_batch.generation == generation)
+        {
+            pthread_cond_wait(&g_batch.wake, &g_batch.lock);
+        }
+        generation = g_batch.generation;
+        if (id < g_batch.helpers)
+        { /* A NEW BATCH ONLY STARTS ONCE EVERY HELPER HAS LEFT THE LAST ONE, SO NONE ARE MISSED */
+            pthread_mutex_unlock(&g_batch.lock);
+            dmgl_batch_drain();
+            pthread_mutex_lock(&g_batch.lock);
+            if (!--g_batch.active)
+            {
+                pthread_cond_broadcast(&g_batch.done);
+            }
+        }
+    }
+    return NULL;
+}
+
+void dmgl_batch_run(uint32_t count, uint32_t threads, void (*function)(uint32_t index, void *argument), void *argument)
+{
+    if ((threads < 2) || (count < 2))
+    {
+        for (uint32_t index = 0; index < count; ++index)
+        {
+            function(index, argument);
+        }
+        return;
+    }
+    pthread_mutex_lock(&g_batch.lock);
+    while (g_batch.busy)
+    {
+        pthread_cond_wait(&g_batch.done, &g_batch.lock);
+    }
+    g_batch.busy = true;
+    while (g_batch.threads < (threads - 1))
+    { /* WORKERS ARE STARTED ON DEMAND AND KEPT FOR LATER BATCHES */
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, dmgl_batch_worker, (void *)(uintptr_t)g_batch.threads))
+        {
+            break;
+        }
+        pthread_detach(thread);
+        ++g_batch.threads;
+    }
+    g_batch.helpers = ((threads - 1) < g_batch.threads) ? (threads - 1) : g_batch.threads;
+    g_batch.active = g_batch.helpers;
+    g_batch.count = count;
+    g_batch.next = 0;
+    g_batch.function = function;
+    g_batch.argument = argument;
+    ++g_batch.generation;
+    pthread_cond_broadcast(&g_batch.wake);
+    pthread_mutex_unlock(&g_batch.lock);
+    dmgl_batch_drain();
+    pthread_mutex_lock(&g_batch.lock);
+    while (g_batch.active)
+    {
+        pthread_cond_wait(&g_batch.done, &g_batch.lock);
+    }
+    g_batch.busy = false;
+    pthread_cond_broadcast(&g_batch.done);
+    pthread_mutex_unlock(&g_batch.lock);
+}
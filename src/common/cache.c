@@ -0,0 +1,126 @@
+/*
+ * SPDX-FileCopyrightText: 2023 David Jolly <majestic53@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <common.h>
+
+/*
+ * CACHE LAYOUT (LITTLE-ENDIAN)
+ * 0x00: MAGIC ("dmc")
+ * 0x04: PATCH
+ * 0x08: ROM GLOBAL CHECKSUM
+ * 0x0A: RAM HASH (SAVE DATA THE INSTANCE WAS CREATED WITH)
+ * 0x12: STATE LENGTH
+ * 0x16: STATE
+ */
+
+#define DMGL_CACHE_HEADER 0x16
+
+static void dmgl_cache_path(char *const path, size_t length, const char *const prefix, uint16_t checksum)
+{
+    snprintf(path, length, "%s-%04X-%07x.dmc", prefix, checksum, DMGL_PATCH);
+}
+
+int dmgl_cache_read(const char *const prefix, uint16_t checksum, uint64_t ram)
+{
+    int file = -1, result = EXIT_SUCCESS;
+    char magic[4] = {}, path[4096] = {};
+    uint8_t *data = NULL;
+    struct stat status = {};
+    dmgl_state_t header = {};
+    dmgl_cache_path(path, sizeof (path), prefix, checksum);
+    if ((file = open(path, O_RDONLY)) < 0)
+    {
+        return DMGL_ERROR("Failed to open cache -- %s", path);
+    }
+    if (fstat(file, &status) || (status.st_size < DMGL_CACHE_HEADER) || (status.st_size > UINT32_MAX))
+    {
+        close(file);
+        return DMGL_ERROR("Invalid cache length -- %s", path);
+    }
+    if ((data = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, file, 0)) == MAP_FAILED)
+    {
+        close(file);
+        return DMGL_ERROR("Failed to map cache -- %s", path);
+    }
+    close(file);
+    header.data = data;
+    header.length = DMGL_CACHE_HEADER;
+    dmgl_state_read(&header, magic, sizeof (magic));
+    if (strncmp(magic, "dmc", sizeof (magic)))
+    {
+        result = DMGL_ERROR("Invalid cache magic -- %s", path);
+    }
+    else if ((dmgl_state_read_32(&header) != DMGL_PATCH) || (dmgl_state_read_16(&header) != checksum))
+    { /* A DIFFERENT CORE OR CARTRIDGE MAY LAY OUT STATE DIFFERENTLY */
+        result = DMGL_ERROR("Stale cache -- %s", path);
+    }
+    else if (dmgl_state_read_64(&header) != ram)
+    {
+        result = DMGL_ERROR("Mismatched cache ram hash -- %016lX", (unsigned long)ram);
+    }
+    else if (dmgl_state_read_32(&header) != (status.st_size - DMGL_CACHE_HEADER))
+    {
+        result = DMGL_ERROR("Invalid cache length -- %s", path);
+    }
+    else
+    {
+        result = dmgl_state_load(data + DMGL_CACHE_HEADER, status.st_size - DMGL_CACHE_HEADER);
+    }
+    munmap(data, status.st_size);
+    return result;
+}
+
+int dmgl_cache_write(const char *const prefix, uint16_t checksum, uint64_t ram)
+{
+    FILE *file = NULL;
+    char path[4096] = {}, temporary[sizeof (path) + 4] = {};
+    uint32_t length = dmgl_state_length();
+    dmgl_state_t header = {};
+    int result = EXIT_SUCCESS;
+    if (!(header.data = malloc(DMGL_CACHE_HEADER + length)))
+    {
+        return DMGL_ERROR("Failed to allocate cache -- %u bytes", DMGL_CACHE_HEADER + length);
+    }
+    header.length = DMGL_CACHE_HEADER;
+    dmgl_state_write(&header, "dmc", 4);
+    dmgl_state_write_32(&header, DMGL_PATCH);
+    dmgl_state_write_16(&header, checksum);
+    dmgl_state_write_64(&header, ram);
+    dmgl_state_write_32(&header, length);
+    if ((result = dmgl_state_save(header.data + DMGL_CACHE_HEADER, length)) == EXIT_SUCCESS)
+    { /* WRITE BESIDE THE CACHE AND RENAME, SO READERS NEVER MAP A PARTIAL FILE */
+        dmgl_cache_path(path, sizeof (path), prefix, checksum);
+        snprintf(temporary, sizeof (temporary), "%s.tmp", path);
+        if (!(file = fopen(temporary, "wb")))
+        {
+            result = DMGL_ERROR("Failed to open cache -- %s", temporary);
+        }
+        else
+        {
+            if (fwrite(header.data, sizeof (*header.data), DMGL_CACHE_HEADER + length, file) != (DMGL_CACHE_HEADER + length))
+            {
+                result = DMGL_ERROR("Failed to write cache -- %s", temporary);
+            }
+            if (fclose(file) && (result == EXIT_SUCCESS))
+            {
+                result = DMGL_ERROR("Failed to write cache -- %s", temporary);
+            }
+            if ((result != EXIT_SUCCESS) || rename(temporary, path))
+            {
+                unlink(temporary);
+                if (result == EXIT_SUCCESS)
+                {
+                    result = DMGL_ERROR("Failed to rename cache -- %s", path);
+                }
+            }
+        }
+    }
+    free(header.data);
+    return result;
+}
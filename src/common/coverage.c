@@ -0,0 +1,137 @@
+/*
+ * SPDX-FileCopyrightText: 2023 David Jolly <majestic53@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <unistd.h>
+#include <common.h>
+
+/*
+ * COVERAGE LAYOUT (LITTLE-ENDIAN)
+ * 0x00: MAGIC ("dmv")
+ * 0x04: ROM GLOBAL CHECKSUM
+ * 0x06: ROM BANK COUNT
+ * 0x08: PER BANK, A BIT PER ADDRESS EXECUTED AS AN OPCODE (0x800 BYTES), THEN READ AS DATA (0x800 BYTES)
+ */
+
+#define DMGL_COVERAGE_HEADER 0x08
+
+struct dmgl_coverage_s
+{
+    uint8_t (*bank)[2][0x800];
+    uint32_t count;
+    uint16_t checksum;
+};
+
+static void dmgl_coverage_read(dmgl_coverage_t *const coverage, const char *const path)
+{
+    FILE *file = NULL;
+    char magic[4] = {};
+    uint8_t data[DMGL_COVERAGE_HEADER] = {};
+    dmgl_state_t header = { .data = data, .length = sizeof (data), };
+    if (!(file = fopen(path, "rb")))
+    { /* NOTHING RECORDED YET */
+        return;
+    }
+    if (fread(data, sizeof (*data), sizeof (data), file) == sizeof (data))
+    {
+        dmgl_state_read(&header, magic, sizeof (magic));
+        if (!strncmp(magic, "dmv", sizeof (magic)) && (dmgl_state_read_16(&header) == coverage->checksum)
+                && (dmgl_state_read_16(&header) == coverage->count)
+                && (fread(coverage->bank, sizeof (*coverage->bank), coverage->count, file) != coverage->count))
+        { /* A SHORT FILE IS DISCARDED RATHER THAN HALF MERGED */
+            memset(coverage->bank, 0, coverage->count * sizeof (*coverage->bank));
+        }
+    }
+    fclose(file);
+}
+
+dmgl_coverage_t *dmgl_coverage_create(const char *const path, uint16_t checksum, uint32_t rom)
+{
+    dmgl_coverage_t *result = NULL;
+    if (!(result = calloc(1, sizeof (*result))))
+    {
+        DMGL_ERROR("Failed to allocate coverage -- %zu bytes", sizeof (*result));
+        return NULL;
+    }
+    if (rom && !(result->bank = calloc(rom, sizeof (*result->bank))))
+    {
+        DMGL_ERROR("Failed to allocate coverage -- %u rom banks", rom);
+        dmgl_coverage_destroy(result);
+        return NULL;
+    }
+    result->count = rom;
+    result->checksum = checksum;
+    dmgl_coverage_read(result, path); /* A FILE FROM ANOTHER CARTRIDGE IS IGNORED AND OVERWRITTEN */
+    return result;
+}
+
+void dmgl_coverage_destroy(dmgl_coverage_t *const coverage)
+{
+    if (coverage)
+    {
+        free(coverage->bank);
+        free(coverage);
+    }
+}
+
+void dmgl_coverage_mark(dmgl_coverage_t *const coverage, uint8_t type, uint16_t bank, uint16_t address)
+{
+    if (bank < coverage->count)
+    {
+        address &= 0x3FFF;
+        coverage->bank[bank][type >> 1][address >> 3] |= 1 << (address & 7);
+    }
+}
+
+uint8_t dmgl_coverage_test(const dmgl_coverage_t *const coverage, uint16_t bank, uint16_t address)
+{
+    uint8_t result = 0;
+    if (bank < coverage->count)
+    {
+        address &= 0x3FFF;
+        for (uint8_t type = DMGL_COVERAGE_CODE; type <= DMGL_COVERAGE_DATA; type <<= 1)
+        {
+            if (coverage->bank[bank][type >> 1][address >> 3] & (1 << (address & 7)))
+            {
+                result |= type;
+            }
+        }
+    }
+    return result;
+}
+
+int dmgl_coverage_write(const dmgl_coverage_t *const coverage, const char *const path)
+{
+    FILE *file = NULL;
+    char temporary[4096] = {};
+    uint8_t data[DMGL_COVERAGE_HEADER] = {};
+    dmgl_state_t header = { .data = data, .length = sizeof (data), };
+    int result = EXIT_SUCCESS;
+    dmgl_state_write(&header, "dmv", 4);
+    dmgl_state_write_16(&header, coverage->checksum);
+    dmgl_state_write_16(&header, coverage->count);
+    snprintf(temporary, sizeof (temporary), "%s.tmp", path);
+    if (!(file = fopen(temporary, "wb")))
+    {
+        return DMGL_ERROR("Failed to open coverage -- %s", temporary);
+    }
+    if ((fwrite(data, sizeof (*data), sizeof (data), file) != sizeof (data))
+            || (fwrite(coverage->bank, sizeof (*coverage->bank), coverage->count, file) != coverage->count))
+    {
+        result = DMGL_ERROR("Failed to write coverage -- %s", temporary);
+    }
+    if (fclose(file) && (result == EXIT_SUCCESS))
+    {
+        result = DMGL_ERROR("Failed to write coverage -- %s", temporary);
+    }
+    if ((result != EXIT_SUCCESS) || rename(temporary, path))
+    { /* WRITE BESIDE THE FILE AND RENAME, SO A CRASH NEVER LEAVES HALF A MAP */
+        unlink(temporary);
+        if (result == EXIT_SUCCESS)
+        {
+            result = DMGL_ERROR("Failed to rename coverage -- %s", path);
+        }
+    }
+    return result;
+}
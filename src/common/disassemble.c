@@ -0,0 +1,193 @@
+/*
+ * SPDX-FileCopyrightText: 2023 David Jolly <majestic53@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <common.h>
+
+static const char *const MNEMONIC[] =
+{
+    /* 00 */
+    "NOP", "LD BC,d16", "LD (BC),A", "INC BC", "INC B", "DEC B", "LD B,d8", "RLCA",
+    /* 08 */
+    "LD (a16),SP", "ADD HL,BC", "LD A,(BC)", "DEC BC", "INC C", "DEC C", "LD C,d8", "RRCA",
+    /* 10 */
+    "STOP", "LD DE,d16", "LD (DE),A", "INC DE", "INC D", "DEC D", "LD D,d8", "RLA",
+    /* 18 */
+    "JR r8", "ADD HL,DE", "LD A,(DE)", "DEC DE", "INC E", "DEC E", "LD E,d8", "RRA",
+    /* 20 */
+    "JR NZ,r8", "LD HL,d16", "LD (HL+),A", "INC HL", "INC H", "DEC H", "LD H,d8", "DAA",
+    /* 28 */
+    "JR Z,r8", "ADD HL,HL", "LD A,(HL+)", "DEC HL", "INC L", "DEC L", "LD L,d8", "CPL",
+    /* 30 */
+    "JR NC,r8", "LD SP,d16", "LD (HL-),A", "INC SP", "INC (HL)", "DEC (HL)", "LD (HL),d8", "SCF",
+    /* 38 */
+    "JR C,r8", "ADD HL,SP", "LD A,(HL-)", "DEC SP", "INC A", "DEC A", "LD A,d8", "CCF",
+    /* 40 */
+    "LD B,B", "LD B,C", "LD B,D", "LD B,E", "LD B,H", "LD B,L", "LD B,(HL)", "LD B,A",
+    /* 48 */
+    "LD C,B", "LD C,C", "LD C,D", "LD C,E", "LD C,H", "LD C,L", "LD C,(HL)", "LD C,A",
+    /* 50 */
+    "LD D,B", "LD D,C", "LD D,D", "LD D,E", "LD D,H", "LD D,L", "LD D,(HL)", "LD D,A",
+    /* 58 */
+    "LD E,B", "LD E,C", "LD E,D", "LD E,E", "LD E,H", "LD E,L", "LD E,(HL)", "LD E,A",
+    /* 60 */
+    "LD H,B", "LD H,C", "LD H,D", "LD H,E", "LD H,H", "LD H,L", "LD H,(HL)", "LD H,A",
+    /* 68 */
+    "LD L,B", "LD L,C", "LD L,D", "LD L,E", "LD L,H", "LD L,L", "LD L,(HL)", "LD L,A",
+    /* 70 */
+    "LD (HL),B", "LD (HL),C", "LD (HL),D", "LD (HL),E", "LD (HL),H", "LD (HL),L", "HALT", "LD (HL),A",
+    /* 78 */
+    "LD A,B", "LD A,C", "LD A,D", "LD A,E", "LD A,H", "LD A,L", "LD A,(HL)", "LD A,A",
+    /* 80 */
+    "ADD A,B", "ADD A,C", "ADD A,D", "ADD A,E", "ADD A,H", "ADD A,L", "ADD A,(HL)", "ADD A,A",
+    /* 88 */
+    "ADC A,B", "ADC A,C", "ADC A,D", "ADC A,E", "ADC A,H", "ADC A,L", "ADC A,(HL)", "ADC A,A",
+    /* 90 */
+    "SUB B", "SUB C", "SUB D", "SUB E", "SUB H", "SUB L", "SUB (HL)", "SUB A",
+    /* 98 */
+    "SBC A,B", "SBC A,C", "SBC A,D", "SBC A,E", "SBC A,H", "SBC A,L", "SBC A,(HL)", "SBC A,A",
+    /* A0 */
+    "AND B", "AND C", "AND D", "AND E", "AND H", "AND L", "AND (HL)", "AND A",
+    /* A8 */
+    "XOR B", "XOR C", "XOR D", "XOR E", "XOR H", "XOR L", "XOR (HL)", "XOR A",
+    /* B0 */
+    "OR B", "OR C", "OR D", "OR E", "OR H", "OR L", "OR (HL)", "OR A",
+    /* B8 */
+    "CP B", "CP C", "CP D", "CP E", "CP H", "CP L", "CP (HL)", "CP A",
+    /* C0 */
+    "RET NZ", "POP BC", "JP NZ,a16", "JP a16", "CALL NZ,a16", "PUSH BC", "ADD A,d8", "RST 00H",
+    /* C8 */
+    "RET Z", "RET", "JP Z,a16", "PREFIX CB", "CALL Z,a16", "CALL a16", "ADC A,d8", "RST 08H",
+    /* D0 */
+    "RET NC", "POP DE", "JP NC,a16", "-", "CALL NC,a16", "PUSH DE", "SUB d8", "RST 10H",
+    /* D8 */
+    "RET C", "RETI", "JP C,a16", "-", "CALL C,a16", "-", "SBC A,d8", "RST 18H",
+    /* E0 */
+    "LDH (a8),A", "POP HL", "LD (C),A", "-", "-", "PUSH HL", "AND d8", "RST 20H",
+    /* E8 */
+    "ADD SP,r8", "JP HL", "LD (a16),A", "-", "-", "-", "XOR d8", "RST 28H",
+    /* F0 */
+    "LDH A,(a8)", "POP AF", "LD A,(C)", "DI", "-", "PUSH AF", "OR d8", "RST 30H",
+    /* F8 */
+    "LD HL,SP+r8", "LD SP,HL", "LD A,(a16)", "EI", "-", "-", "CP d8", "RST 38H",
+    /* CB 00 */
+    "RLC B", "RLC C", "RLC D", "RLC E", "RLC H", "RLC L", "RLC (HL)", "RLC A",
+    /* CB 08 */
+    "RRC B", "RRC C", "RRC D", "RRC E", "RRC H", "RRC L", "RRC (HL)", "RRC A",
+    /* CB 10 */
+    "RL B", "RL C", "RL D", "RL E", "RL H", "RL L", "RL (HL)", "RL A",
+    /* CB 18 */
+    "RR B", "RR C", "RR D", "RR E", "RR H", "RR L", "RR (HL)", "RR A",
+    /* CB 20 */
+    "SLA B", "SLA C", "SLA D", "SLA E", "SLA H", "SLA L", "SLA (HL)", "SLA A",
+    /* CB 28 */
+    "SRA B", "SRA C", "SRA D", "SRA E", "SRA H", "SRA L", "SRA (HL)", "SRA A",
+    /* CB 30 */
+    "SWAP B", "SWAP C", "SWAP D", "SWAP E", "SWAP H", "SWAP L", "SWAP (HL)", "SWAP A",
+    /* CB 38 */
+    "SRL B", "SRL C", "SRL D", "SRL E", "SRL H", "SRL L", "SRL (HL)", "SRL A",
+    /* CB 40 */
+    "BIT 0,B", "BIT 0,C", "BIT 0,D", "BIT 0,E", "BIT 0,H", "BIT 0,L", "BIT 0,(HL)", "BIT 0,A",
+    /* CB 48 */
+    "BIT 1,B", "BIT 1,C", "BIT 1,D", "BIT 1,E", "BIT 1,H", "BIT 1,L", "BIT 1,(HL)", "BIT 1,A",
+    /* CB 50 */
+    "BIT 2,B", "BIT 2,C", "BIT 2,D", "BIT 2,E", "BIT 2,H", "BIT 2,L", "BIT 2,(HL)", "BIT 2,A",
+    /* CB 58 */
+    "BIT 3,B", "BIT 3,C", "BIT 3,D", "BIT 3,E", "BIT 3,H", "BIT 3,L", "BIT 3,(HL)", "BIT 3,A",
+    /* CB 60 */
+    "BIT 4,B", "BIT 4,C", "BIT 4,D", "BIT 4,E", "BIT 4,H", "BIT 4,L", "BIT 4,(HL)", "BIT 4,A",
+    /* CB 68 */
+    "BIT 5,B", "BIT 5,C", "BIT 5,D", "BIT 5,E", "BIT 5,H", "BIT 5,L", "BIT 5,(HL)", "BIT 5,A",
+    /* CB 70 */
+    "BIT 6,B", "BIT 6,C", "BIT 6,D", "BIT 6,E", "BIT 6,H", "BIT 6,L", "BIT 6,(HL)", "BIT 6,A",
+    /* CB 78 */
+    "BIT 7,B", "BIT 7,C", "BIT 7,D", "BIT 7,E", "BIT 7,H", "BIT 7,L", "BIT 7,(HL)", "BIT 7,A",
+    /* CB 80 */
+    "RES 0,B", "RES 0,C", "RES 0,D", "RES 0,E", "RES 0,H", "RES 0,L", "RES 0,(HL)", "RES 0,A",
+    /* CB 88 */
+    "RES 1,B", "RES 1,C", "RES 1,D", "RES 1,E", "RES 1,H", "RES 1,L", "RES 1,(HL)", "RES 1,A",
+    /* CB 90 */
+    "RES 2,B", "RES 2,C", "RES 2,D", "RES 2,E", "RES 2,H", "RES 2,L", "RES 2,(HL)", "RES 2,A",
+    /* CB 98 */
+    "RES 3,B", "RES 3,C", "RES 3,D", "RES 3,E", "RES 3,H", "RES 3,L", "RES 3,(HL)", "RES 3,A",
+    /* CB A0 */
+    "RES 4,B", "RES 4,C", "RES 4,D", "RES 4,E", "RES 4,H", "RES 4,L", "RES 4,(HL)", "RES 4,A",
+    /* CB A8 */
+    "RES 5,B", "RES 5,C", "RES 5,D", "RES 5,E", "RES 5,H", "RES 5,L", "RES 5,(HL)", "RES 5,A",
+    /* CB B0 */
+    "RES 6,B", "RES 6,C", "RES 6,D", "RES 6,E", "RES 6,H", "RES 6,L", "RES 6,(HL)", "RES 6,A",
+    /* CB B8 */
+    "RES 7,B", "RES 7,C", "RES 7,D", "RES 7,E", "RES 7,H", "RES 7,L", "RES 7,(HL)", "RES 7,A",
+    /* CB C0 */
+    "SET 0,B", "SET 0,C", "SET 0,D", "SET 0,E", "SET 0,H", "SET 0,L", "SET 0,(HL)", "SET 0,A",
+    /* CB C8 */
+    "SET 1,B", "SET 1,C", "SET 1,D", "SET 1,E", "SET 1,H", "SET 1,L", "SET 1,(HL)", "SET 1,A",
+    /* CB D0 */
+    "SET 2,B", "SET 2,C", "SET 2,D", "SET 2,E", "SET 2,H", "SET 2,L", "SET 2,(HL)", "SET 2,A",
+    /* CB D8 */
+    "SET 3,B", "SET 3,C", "SET 3,D", "SET 3,E", "SET 3,H", "SET 3,L", "SET 3,(HL)", "SET 3,A",
+    /* CB E0 */
+    "SET 4,B", "SET 4,C", "SET 4,D", "SET 4,E", "SET 4,H", "SET 4,L", "SET 4,(HL)", "SET 4,A",
+    /* CB E8 */
+    "SET 5,B", "SET 5,C", "SET 5,D", "SET 5,E", "SET 5,H", "SET 5,L", "SET 5,(HL)", "SET 5,A",
+    /* CB F0 */
+    "SET 6,B", "SET 6,C", "SET 6,D", "SET 6,E", "SET 6,H", "SET 6,L", "SET 6,(HL)", "SET 6,A",
+    /* CB F8 */
+    "SET 7,B", "SET 7,C", "SET 7,D", "SET 7,E", "SET 7,H", "SET 7,L", "SET 7,(HL)", "SET 7,A",
+};
+
+uint8_t dmgl_disassemble(char *const text, uint32_t length, uint16_t address, const uint8_t *const data)
+{
+    uint8_t result = 1;
+    const char *mnemonic = NULL, *operand = NULL;
+    if (!text || !length || !data)
+    {
+        return 0;
+    }
+    if (data[0] == 0xCB)
+    {
+        snprintf(text, length, "%s", MNEMONIC[256 + data[1]]);
+        return 2;
+    }
+    mnemonic = MNEMONIC[data[0]];
+    if ((operand = strstr(mnemonic, "d16")) || (operand = strstr(mnemonic, "a16")))
+    {
+        snprintf(text, length, "%.*s$%04X%s", (int)(operand - mnemonic), mnemonic, data[1] | (data[2] << 8), operand + 3);
+        result = 3;
+    }
+    else if ((operand = strstr(mnemonic, "a8")))
+    { /* LDH ADDRESSES ARE OFFSETS INTO 0xFF00 */
+        snprintf(text, length, "%.*s$FF%02X%s", (int)(operand - mnemonic), mnemonic, data[1], operand + 2);
+        result = 2;
+    }
+    else if ((operand = strstr(mnemonic, "d8")))
+    {
+        snprintf(text, length, "%.*s$%02X%s", (int)(operand - mnemonic), mnemonic, data[1], operand + 2);
+        result = 2;
+    }
+    else if ((operand = strstr(mnemonic, "r8")))
+    {
+        if (mnemonic[0] == 'J')
+        { /* RELATIVE JUMPS SHOW THEIR TARGET */
+            snprintf(text, length, "%.*s$%04X%s", (int)(operand - mnemonic), mnemonic, (uint16_t)(address + 2 + (int8_t)data[1]), operand + 2);
+        }
+        else
+        { /* SIGNED SP OFFSETS DROP THE '+' WHEN NEGATIVE */
+            int prefix = (operand - mnemonic) - (((int8_t)data[1] < 0) && (operand[-1] == '+'));
+            snprintf(text, length, "%.*s%s$%02X%s", prefix, mnemonic, ((int8_t)data[1] < 0) ? "-" : "",
+                abs((int8_t)data[1]), operand + 2);
+        }
+        result = 2;
+    }
+    else
+    {
+        snprintf(text, length, "%s", mnemonic);
+    }
+    return result;
+}
+
+const char *dmgl_mnemonic(uint16_t opcode)
+{
+    return MNEMONIC[opcode & 0x1FF];
+}
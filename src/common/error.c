@@ -5,7 +5,7 @@
 
 #include <common.h>
 
-static char g_error[256] = {};
+static __thread char g_error[256] = {};
 
 const char *dmgl_error(void)
 {
@@ -0,0 +1,15 @@
+/*
+ * SPDX-FileCopyrightText: 2023 David Jolly <majestic53@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <common.h>
+
+uint64_t dmgl_hash(uint64_t hash, const uint8_t *const data, uint32_t length)
+{
+    for (uint32_t index = 0; index < length; ++index)
+    { /* FNV-1A */
+        hash = (hash ^ data[index]) * 0x00000100000001B3;
+    }
+    return hash;
+}
@@ -0,0 +1,145 @@
+/*
+ * SPDX-FileCopyrightText: 2023 David Jolly <majestic53@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <common.h>
+
+typedef uint64_t dmgl_heatmap_page_t[3]; /* READ, WRITE, EXECUTE */
+
+struct dmgl_heatmap_s
+{
+    uint64_t mapper[8]; /* WRITES TO EACH 4KB SLICE OF THE MAPPER REGISTERS */
+    dmgl_heatmap_page_t page[0x80]; /* 0x8000-0xFFFF, LESS CARTRIDGE RAM */
+    struct
+    {
+        dmgl_heatmap_page_t (*page)[0x40];
+        uint64_t *select;
+        uint32_t count;
+    } rom;
+    struct
+    {
+        dmgl_heatmap_page_t (*page)[0x20];
+        uint64_t *select;
+        uint32_t count;
+    } ram;
+};
+
+static void dmgl_heatmap_row(FILE *file, const char *const region, uint32_t bank, uint16_t address, const dmgl_heatmap_page_t page, uint64_t select)
+{
+    fprintf(file, "%s,%u,0x%04X,%llu,%llu,%llu,%llu\n", region, bank, address, (unsigned long long)page[DMGL_HEATMAP_READ],
+        (unsigned long long)page[DMGL_HEATMAP_WRITE], (unsigned long long)page[DMGL_HEATMAP_EXECUTE], (unsigned long long)select);
+}
+
+void dmgl_heatmap_access(dmgl_heatmap_t *const heatmap, uint8_t type, uint16_t bank, uint16_t address)
+{
+    switch (address)
+    {
+        case 0x0000 ... 0x7FFF: /* ROM */
+            if (bank < heatmap->rom.count)
+            {
+                ++heatmap->rom.page[bank][(address & 0x3FFF) >> 8][type];
+            }
+            break;
+        case 0xA000 ... 0xBFFF: /* CARTRIDGE RAM */
+            if (bank < heatmap->ram.count)
+            {
+                ++heatmap->ram.page[bank][(address - 0xA000) >> 8][type];
+            }
+            break;
+        default:
+            ++heatmap->page[(address - 0x8000) >> 8][type];
+            break;
+    }
+}
+
+dmgl_heatmap_t *dmgl_heatmap_create(uint32_t rom, uint32_t ram)
+{
+    dmgl_heatmap_t *result = NULL;
+    if (!(result = calloc(1, sizeof (*result))))
+    {
+        DMGL_ERROR("Failed to allocate heatmap -- %zu bytes", sizeof (*result));
+        return NULL;
+    }
+    if ((rom && (!(result->rom.page = calloc(rom, sizeof (*result->rom.page))) || !(result->rom.select = calloc(rom, sizeof (uint64_t)))))
+            || (ram && (!(result->ram.page = calloc(ram, sizeof (*result->ram.page))) || !(result->ram.select = calloc(ram, sizeof (uint64_t))))))
+    {
+        DMGL_ERROR("Failed to allocate heatmap -- %u rom banks, %u ram banks", rom, ram);
+        dmgl_heatmap_destroy(result);
+        return NULL;
+    }
+    result->rom.count = rom;
+    result->ram.count = ram;
+    return result;
+}
+
+void dmgl_heatmap_destroy(dmgl_heatmap_t *const heatmap)
+{
+    if (heatmap)
+    {
+        free(heatmap->ram.page);
+        free(heatmap->ram.select);
+        free(heatmap->rom.page);
+        free(heatmap->rom.select);
+        free(heatmap);
+    }
+}
+
+void dmgl_heatmap_mapper(dmgl_heatmap_t *const heatmap, uint16_t address)
+{
+    ++heatmap->mapper[(address >> 12) & 7];
+}
+
+void dmgl_heatmap_select(dmgl_heatmap_t *const heatmap, uint16_t address, uint16_t bank)
+{
+    if ((address < 0x8000) && (bank < heatmap->rom.count))
+    {
+        ++heatmap->rom.select[bank];
+    }
+    else if ((address >= 0xA000) && (bank < heatmap->ram.count))
+    {
+        ++heatmap->ram.select[bank];
+    }
+}
+
+int dmgl_heatmap_write(const dmgl_heatmap_t *const heatmap, const char *const path)
+{
+    FILE *file = NULL;
+    if (!(file = fopen(path, "w")))
+    {
+        return DMGL_ERROR("Failed to open heatmap -- %s", path);
+    }
+    fprintf(file, "region,bank,address,read,write,execute,select\n");
+    for (uint32_t bank = 0; bank < heatmap->rom.count; ++bank)
+    { /* EVERY PAGE OF EVERY BANK, SO RUNS LINE UP ROW FOR ROW */
+        for (uint16_t page = 0; page < 0x40; ++page)
+        {
+            dmgl_heatmap_row(file, "rom", bank, (bank ? 0x4000 : 0x0000) + (page << 8), heatmap->rom.page[bank][page], heatmap->rom.select[bank]);
+        }
+    }
+    for (uint16_t page = 0x80; page < 0xA0; ++page)
+    {
+        dmgl_heatmap_row(file, "video", 0, page << 8, heatmap->page[page - 0x80], 0);
+    }
+    for (uint32_t bank = 0; bank < heatmap->ram.count; ++bank)
+    {
+        for (uint16_t page = 0; page < 0x20; ++page)
+        {
+            dmgl_heatmap_row(file, "cartridge", bank, 0xA000 + (page << 8), heatmap->ram.page[bank][page], heatmap->ram.select[bank]);
+        }
+    }
+    for (uint16_t page = 0xC0; page < 0x100; ++page)
+    { /* THE LAST PAGE HOLDS BOTH THE REGISTERS AND HIGH RAM */
+        dmgl_heatmap_row(file, (page < 0xFE) ? "work" : ((page == 0xFE) ? "object" : "io"), 0, page << 8, heatmap->page[page - 0x80], 0);
+    }
+    for (uint8_t slice = 0; slice < 8; ++slice)
+    {
+        const dmgl_heatmap_page_t page = { 0, heatmap->mapper[slice], 0, };
+        dmgl_heatmap_row(file, "mapper", 0, slice << 12, page, 0);
+    }
+    if (fclose(file))
+    {
+        return DMGL_ERROR("Failed to write heatmap -- %s", path);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,205 @@
+/*
+ * SPDX-FileCopyrightText: 2023 David Jolly <majestic53@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <common.h>
+
+/*
+ * MOVIE LAYOUT (LITTLE-ENDIAN)
+ * 0x00: MAGIC ("mov")
+ * 0x04: FLAG (MAJOR[3:0], MINOR[7:4], CYCLE[8], SKIP BOOTROM[9])
+ * 0x08: FRAME COUNT
+ * 0x0C: RECORD COUNT
+ * 0x10: ROM HASH
+ * 0x18: RAM HASH
+ * 0x20: RECORDS (FRAME: STATE[1], CYCLE: CYCLE[8] + STATE[1])
+ */
+
+#define DMGL_MOVIE_CYCLE (1 << 8)
+#define DMGL_MOVIE_HEADER 0x20
+#define DMGL_MOVIE_SKIP (1 << 9)
+
+static uint64_t dmgl_movie_read(const uint8_t *const data, uint8_t length)
+{
+    uint64_t result = 0;
+    for (uint8_t index = 0; index < length; ++index)
+    {
+        result |= (uint64_t)data[index] << (8 * index);
+    }
+    return result;
+}
+
+static void dmgl_movie_write(uint8_t *const data, uint64_t value, uint8_t length)
+{
+    for (uint8_t index = 0; index < length; ++index)
+    {
+        data[index] = value >> (8 * index);
+    }
+}
+
+static uint8_t dmgl_movie_pack(const bool (*state)[8])
+{
+    uint8_t result = 0;
+    for (uint8_t button = 0; button < 8; ++button)
+    {
+        if ((*state)[button])
+        {
+            result |= 1 << button;
+        }
+    }
+    return result;
+}
+
+static void dmgl_movie_unpack(uint8_t value, bool (*state)[8])
+{
+    for (uint8_t button = 0; button < 8; ++button)
+    {
+        (*state)[button] = ((value & (1 << button)) == (1 << button));
+    }
+}
+
+static void dmgl_movie_append(dmgl_movie_t *const movie, const uint8_t *const data, uint32_t length)
+{
+    if ((movie->context->movie.length + length) > movie->capacity)
+    {
+        uint8_t *buffer = NULL;
+        uint32_t capacity = movie->capacity ? (2 * movie->capacity) : 4096;
+        if (!(buffer = realloc(movie->context->movie.data, capacity)))
+        {
+            DMGL_ERROR("Failed to allocate movie -- %u bytes", capacity);
+            movie->recording = false;
+            return;
+        }
+        movie->context->movie.data = buffer;
+        movie->capacity = capacity;
+    }
+    memcpy(movie->context->movie.data + movie->context->movie.length, data, length);
+    movie->context->movie.length += length;
+    ++movie->count;
+}
+
+static void dmgl_movie_next(dmgl_movie_t *const movie)
+{
+    movie->next = UINT64_MAX;
+    if ((movie->offset + 9) <= movie->context->movie.length)
+    {
+        movie->next = dmgl_movie_read(movie->context->movie.data + movie->offset, 8);
+    }
+}
+
+void dmgl_movie_cycle(dmgl_movie_t *const movie, uint64_t cycle, bool (*state)[8])
+{
+    while (movie->next == cycle)
+    {
+        dmgl_movie_unpack(movie->context->movie.data[movie->offset + 8], state);
+        movie->offset += 9;
+        dmgl_movie_next(movie);
+    }
+}
+
+bool dmgl_movie_frame(dmgl_movie_t *const movie, uint64_t cycle, bool (*state)[8])
+{
+    if (movie->recording)
+    {
+        uint8_t record[9] = {}, value = dmgl_movie_pack((const bool (*)[8])state);
+        if (!movie->cycle)
+        {
+            dmgl_movie_append(movie, &value, 1);
+        }
+        else if (!movie->frame || (value != movie->state))
+        {
+            dmgl_movie_write(record, cycle, 8);
+            record[8] = value;
+            dmgl_movie_append(movie, record, sizeof (record));
+        }
+        movie->state = value;
+        ++movie->frame;
+    }
+    else if (movie->playing)
+    {
+        if (movie->frame >= movie->frames)
+        {
+            return false;
+        }
+        if (!movie->cycle)
+        {
+            dmgl_movie_unpack(movie->context->movie.data[movie->offset++], state);
+        }
+        ++movie->frame;
+    }
+    return true;
+}
+
+int dmgl_movie_initialize(dmgl_movie_t *const movie, dmgl_t *const context, uint64_t rom, uint64_t ram)
+{
+    memset(movie, 0, sizeof (*movie));
+    movie->context = context;
+    movie->next = UINT64_MAX;
+    if (context->movie.record)
+    {
+        uint8_t header[DMGL_MOVIE_HEADER] = {};
+        context->movie.data = NULL;
+        context->movie.length = 0;
+        movie->cycle = context->movie.cycle;
+        movie->recording = true;
+        movie->skip = context->bootrom.skip;
+        strcpy((char *)header, "mov");
+        dmgl_movie_write(header + 0x04, DMGL_MAJOR | (DMGL_MINOR << 4) | (movie->cycle ? DMGL_MOVIE_CYCLE : 0) | (movie->skip ? DMGL_MOVIE_SKIP : 0), 4);
+        dmgl_movie_write(header + 0x10, rom, 8);
+        dmgl_movie_write(header + 0x18, ram, 8);
+        dmgl_movie_append(movie, header, sizeof (header));
+        movie->count = 0;
+        if (!movie->recording)
+        {
+            return EXIT_FAILURE;
+        }
+    }
+    else if (context->movie.data)
+    {
+        uint32_t expected = DMGL_MOVIE_HEADER, flag = 0;
+        if ((context->movie.length < expected) || strcmp((const char *)context->movie.data, "mov"))
+        {
+            return DMGL_ERROR("Invalid movie -- %u bytes", context->movie.length);
+        }
+        if (((flag = dmgl_movie_read(context->movie.data + 0x04, 4)) & 0x0F) != DMGL_MAJOR)
+        {
+            return DMGL_ERROR("Unsupported movie version -- %u (expecting %u)", flag & 0x0F, DMGL_MAJOR);
+        }
+        if (dmgl_movie_read(context->movie.data + 0x10, 8) != rom)
+        {
+            return DMGL_ERROR("Mismatched movie rom hash -- %016lX", (unsigned long)rom);
+        }
+        if (dmgl_movie_read(context->movie.data + 0x18, 8) != ram)
+        {
+            return DMGL_ERROR("Mismatched movie ram hash -- %016lX", (unsigned long)ram);
+        }
+        movie->cycle = ((flag & DMGL_MOVIE_CYCLE) == DMGL_MOVIE_CYCLE);
+        movie->skip = ((flag & DMGL_MOVIE_SKIP) == DMGL_MOVIE_SKIP);
+        movie->frames = dmgl_movie_read(context->movie.data + 0x08, 4);
+        movie->count = dmgl_movie_read(context->movie.data + 0x0C, 4);
+        expected += movie->count * (movie->cycle ? 9 : 1);
+        if ((context->movie.length != expected) || (!movie->cycle && (movie->count != movie->frames)))
+        {
+            return DMGL_ERROR("Invalid movie length -- %u bytes (expecting %u bytes)", context->movie.length, expected);
+        }
+        movie->offset = DMGL_MOVIE_HEADER;
+        movie->playing = true;
+        if (movie->cycle)
+        {
+            dmgl_movie_next(movie);
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+void dmgl_movie_uninitialize(dmgl_movie_t *const movie)
+{
+    if (movie->recording)
+    {
+        dmgl_movie_write(movie->context->movie.data + 0x08, movie->frame, 4);
+        dmgl_movie_write(movie->context->movie.data + 0x0C, movie->count, 4);
+        movie->recording = false;
+    }
+    movie->playing = false;
+}
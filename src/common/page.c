@@ -0,0 +1,48 @@
+/*
+ * SPDX-FileCopyrightText: 2023 David Jolly <majestic53@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <common.h>
+
+dmgl_page_t *dmgl_page_allocate(uint8_t value)
+{
+    dmgl_page_t *result = NULL;
+    if (!(result = malloc(sizeof (*result))))
+    {
+        DMGL_ERROR("Failed to allocate page -- %zu bytes", sizeof (*result));
+        return NULL;
+    }
+    result->count = 1;
+    memset(result->data, value, sizeof (result->data));
+    return result;
+}
+
+uint8_t *dmgl_page_copy(dmgl_page_t **page)
+{
+    dmgl_page_t *copy = NULL;
+    if (!(copy = malloc(sizeof (*copy))))
+    { /* KEEP WRITING THROUGH THE SHARED PAGE RATHER THAN FAULT MID-INSTRUCTION */
+        DMGL_ERROR("Failed to copy page -- %zu bytes", sizeof (*copy));
+        return (*page)->data;
+    }
+    copy->count = 1;
+    memcpy(copy->data, (*page)->data, sizeof (copy->data));
+    dmgl_page_free(*page);
+    *page = copy;
+    return copy->data;
+}
+
+void dmgl_page_free(dmgl_page_t *page)
+{
+    if (page && !__atomic_sub_fetch(&page->count, 1, __ATOMIC_ACQ_REL))
+    {
+        free(page);
+    }
+}
+
+dmgl_page_t *dmgl_page_share(dmgl_page_t *page)
+{
+    __atomic_add_fetch(&page->count, 1, __ATOMIC_RELAXED);
+    return page;
+}
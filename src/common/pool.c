@@ -0,0 +1,125 @@
+/*
+ * SPDX-FileCopyrightText: 2023 David Jolly <majestic53@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <pthread.h>
+#include <common.h>
+
+struct dmgl_pool_s
+{
+    pthread_rwlock_t lock;
+    dmgl_instance_t **entry;
+    uint32_t capacity;
+    uint32_t count;
+};
+
+static uint64_t dmgl_pool_mix(uint64_t seed)
+{ /* SPLITMIX64, SO NEIGHBOURING SEEDS PICK UNRELATED ENTRIES */
+    seed += 0x9E3779B97F4A7C15;
+    seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9;
+    seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EB;
+    return seed ^ (seed >> 31);
+}
+
+int dmgl_pool_capture(dmgl_pool_t *const pool, const dmgl_instance_t *const instance)
+{
+    int result = EXIT_SUCCESS;
+    dmgl_instance_t *entry = NULL;
+    if (!pool)
+    {
+        return DMGL_ERROR("Invalid pool -- %p", pool);
+    }
+    if (!(entry = dmgl_fork(instance)))
+    {
+        return EXIT_FAILURE;
+    }
+    pthread_rwlock_wrlock(&pool->lock);
+    if (pool->count == pool->capacity)
+    {
+        dmgl_instance_t **buffer = NULL;
+        uint32_t capacity = pool->capacity ? (2 * pool->capacity) : 16;
+        if (!(buffer = realloc(pool->entry, capacity * sizeof (*buffer))))
+        {
+            result = DMGL_ERROR("Failed to allocate pool -- %zu bytes", capacity * sizeof (*buffer));
+        }
+        else
+        {
+            pool->entry = buffer;
+            pool->capacity = capacity;
+        }
+    }
+    if (result == EXIT_SUCCESS)
+    {
+        pool->entry[pool->count++] = entry;
+    }
+    pthread_rwlock_unlock(&pool->lock);
+    if (result != EXIT_SUCCESS)
+    {
+        dmgl_destroy(entry);
+    }
+    return result;
+}
+
+dmgl_pool_t *dmgl_pool_create(void)
+{
+    dmgl_pool_t *result = NULL;
+    if (!(result = calloc(1, sizeof (*result))))
+    {
+        DMGL_ERROR("Failed to allocate pool -- %zu bytes", sizeof (*result));
+        return NULL;
+    }
+    if (pthread_rwlock_init(&result->lock, NULL))
+    {
+        free(result);
+        DMGL_ERROR("Failed to initialize pool lock");
+        return NULL;
+    }
+    return result;
+}
+
+void dmgl_pool_destroy(dmgl_pool_t *const pool)
+{
+    if (pool)
+    {
+        for (uint32_t index = 0; index < pool->count; ++index)
+        {
+            dmgl_destroy(pool->entry[index]);
+        }
+        free(pool->entry);
+        pthread_rwlock_destroy(&pool->lock);
+        free(pool);
+    }
+}
+
+uint32_t dmgl_pool_length(dmgl_pool_t *const pool)
+{
+    uint32_t result = 0;
+    if (pool)
+    {
+        pthread_rwlock_rdlock(&pool->lock);
+        result = pool->count;
+        pthread_rwlock_unlock(&pool->lock);
+    }
+    return result;
+}
+
+int dmgl_pool_reset(dmgl_pool_t *const pool, dmgl_instance_t *const instance, uint64_t seed)
+{
+    int result = EXIT_SUCCESS;
+    if (!pool)
+    {
+        return DMGL_ERROR("Invalid pool -- %p", pool);
+    }
+    pthread_rwlock_rdlock(&pool->lock);
+    if (!pool->count)
+    {
+        result = DMGL_ERROR("Empty pool -- %p", pool);
+    }
+    else
+    { /* ENTRIES ARE NEVER STEPPED, SO MANY THREADS CAN RESET FROM THEM AT ONCE */
+        result = dmgl_reset(instance, pool->entry[dmgl_pool_mix(seed) % pool->count]);
+    }
+    pthread_rwlock_unlock(&pool->lock);
+    return result;
+}
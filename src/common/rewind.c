@@ -0,0 +1,255 @@
+/*
+ * SPDX-FileCopyrightText: 2023 David Jolly <majestic53@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <common.h>
+
+/*
+ * REWIND ENTRY LAYOUT (HOST-ENDIAN, WRAPS AROUND RING)
+ * 0x00: FRAME
+ * 0x04: LENGTH
+ * 0x08: DELTA (LENGTH BYTES)
+ * ....: LENGTH
+ *
+ * DELTA ENCODING
+ * Each delta is the XOR of two consecutive states, stored as groups of
+ * (ZERO COUNT, LITERAL COUNT, LITERALS[]) with LEB128 counts. Literal runs
+ * only break on three or more zeros, so a delta never exceeds its state
+ * length by more than a few bytes per 16KB literal run (see DMGL_REWIND_BOUND).
+ */
+
+#define DMGL_REWIND_BOUND(_LENGTH_) \
+    ((_LENGTH_) + ((_LENGTH_) / 4096) + 16)
+
+#define DMGL_REWIND_HEADER 8
+#define DMGL_REWIND_TRAILER 4
+
+static uint32_t dmgl_rewind_decode(uint8_t *const state, uint32_t length, const uint8_t *const data, uint32_t size)
+{
+    uint32_t offset = 0, position = 0;
+    while (position < size)
+    {
+        uint32_t count[2] = {};
+        for (uint8_t index = 0; index < 2; ++index)
+        {
+            for (uint8_t shift = 0; (position < size) && (shift < 32); shift += 7)
+            {
+                uint8_t value = data[position++];
+                count[index] |= (uint32_t)(value & 0x7F) << shift;
+                if (!(value & 0x80))
+                {
+                    break;
+                }
+            }
+        }
+        if (((offset += count[0]) > length) || (count[1] > (length - offset)) || (count[1] > (size - position)))
+        {
+            break;
+        }
+        for (uint32_t index = 0; index < count[1]; ++index)
+        {
+            state[offset++] ^= data[position++];
+        }
+    }
+    return offset;
+}
+
+static uint32_t dmgl_rewind_encode(const uint8_t *const previous, const uint8_t *const current, uint32_t length, uint8_t *const data)
+{
+    uint32_t offset = 0, position = 0;
+    while (offset < length)
+    {
+        uint32_t count[2] = {}, start = offset;
+        while ((offset < length) && (previous[offset] == current[offset]))
+        {
+            ++offset;
+        }
+        if (offset == length)
+        { /* TRAILING ZEROS */
+            break;
+        }
+        count[0] = offset - start;
+        start = offset;
+        for (uint32_t zero = 0; (offset < length) && (zero < 3); ++offset)
+        {
+            zero = (previous[offset] == current[offset]) ? zero + 1 : 0;
+            if (zero == 3)
+            {
+                offset -= 2;
+                break;
+            }
+        }
+        count[1] = offset - start;
+        while ((count[1] > 0) && (previous[start + count[1] - 1] == current[start + count[1] - 1]))
+        {
+            --count[1];
+        }
+        offset = start + count[1];
+        for (uint8_t index = 0; index < 2; ++index)
+        {
+            do
+            {
+                data[position] = count[index] & 0x7F;
+                if (count[index] >>= 7)
+                {
+                    data[position] |= 0x80;
+                }
+                ++position;
+            }
+            while (count[index]);
+        }
+        for (uint32_t index = start; index < offset; ++index)
+        {
+            data[position++] = previous[index] ^ current[index];
+        }
+    }
+    return position;
+}
+
+static void dmgl_rewind_read(const dmgl_rewind_t *const rewind, uint32_t offset, void *const data, uint32_t length)
+{
+    uint32_t count = 0;
+    offset %= rewind->capacity;
+    count = ((rewind->capacity - offset) < length) ? (rewind->capacity - offset) : length;
+    memcpy(data, &rewind->data[offset], count);
+    memcpy((uint8_t *)data + count, rewind->data, length - count);
+}
+
+static void dmgl_rewind_write(dmgl_rewind_t *const rewind, uint32_t offset, const void *const data, uint32_t length)
+{
+    uint32_t count = 0;
+    offset %= rewind->capacity;
+    count = ((rewind->capacity - offset) < length) ? (rewind->capacity - offset) : length;
+    memcpy(&rewind->data[offset], data, count);
+    memcpy(rewind->data, (const uint8_t *)data + count, length - count);
+}
+
+static void dmgl_rewind_drop(dmgl_rewind_t *const rewind)
+{
+    uint32_t size = 0;
+    dmgl_rewind_read(rewind, rewind->head + sizeof (uint32_t), &size, sizeof (size));
+    size += DMGL_REWIND_HEADER + DMGL_REWIND_TRAILER;
+    rewind->head = (rewind->head + size) % rewind->capacity;
+    rewind->used -= size;
+    --rewind->count;
+}
+
+uint32_t dmgl_rewind_available(const dmgl_rewind_t *const rewind, uint32_t frame)
+{
+    uint32_t oldest = rewind->frame;
+    if (!rewind->valid)
+    {
+        return 0;
+    }
+    if (rewind->count)
+    {
+        dmgl_rewind_read(rewind, rewind->head, &oldest, sizeof (oldest));
+    }
+    return frame - oldest;
+}
+
+int dmgl_rewind_initialize(dmgl_rewind_t *const rewind, dmgl_t *const context, uint32_t length)
+{
+    memset(rewind, 0, sizeof (*rewind));
+    if (!context->rewind.length)
+    {
+        return EXIT_SUCCESS;
+    }
+    rewind->capacity = context->rewind.length;
+    rewind->interval = context->rewind.interval ? context->rewind.interval : 1;
+    rewind->length = length;
+    if (!(rewind->data = malloc(rewind->capacity))
+            || !(rewind->delta = malloc(DMGL_REWIND_BOUND(length)))
+            || !(rewind->state[0] = malloc(length))
+            || !(rewind->state[1] = malloc(length)))
+    {
+        return DMGL_ERROR("Failed to allocate rewind buffer -- %u bytes", rewind->capacity);
+    }
+    rewind->enabled = true;
+    return EXIT_SUCCESS;
+}
+
+uint8_t *dmgl_rewind_pop(dmgl_rewind_t *const rewind, uint32_t frame)
+{
+    if (!rewind->valid)
+    {
+        return NULL;
+    }
+    while ((rewind->frame > frame) && rewind->count)
+    {
+        uint32_t size = 0, start = 0;
+        dmgl_rewind_read(rewind, rewind->tail + rewind->capacity - DMGL_REWIND_TRAILER, &size, sizeof (size));
+        start = (rewind->tail + rewind->capacity - (size + DMGL_REWIND_HEADER + DMGL_REWIND_TRAILER)) % rewind->capacity;
+        dmgl_rewind_read(rewind, start, &rewind->frame, sizeof (rewind->frame));
+        dmgl_rewind_read(rewind, start + DMGL_REWIND_HEADER, rewind->delta, size);
+        dmgl_rewind_decode(rewind->state[0], rewind->length, rewind->delta, size);
+        rewind->tail = start;
+        rewind->used -= size + DMGL_REWIND_HEADER + DMGL_REWIND_TRAILER;
+        --rewind->count;
+    }
+    return rewind->state[0];
+}
+
+uint8_t *dmgl_rewind_pending(dmgl_rewind_t *const rewind, uint32_t frame)
+{
+    if (!rewind->enabled || (rewind->valid && ((frame - rewind->frame) < rewind->interval)))
+    {
+        return NULL;
+    }
+    return rewind->state[1];
+}
+
+void dmgl_rewind_push(dmgl_rewind_t *const rewind, uint32_t frame)
+{
+    uint8_t *swap = NULL;
+    if (rewind->valid)
+    {
+        uint32_t size = dmgl_rewind_encode(rewind->state[1], rewind->state[0], rewind->length, rewind->delta);
+        uint32_t total = size + DMGL_REWIND_HEADER + DMGL_REWIND_TRAILER;
+        if (total > rewind->capacity)
+        { /* DELTA LARGER THAN BUFFER */
+            rewind->count = 0;
+            rewind->head = 0;
+            rewind->tail = 0;
+            rewind->used = 0;
+        }
+        else
+        {
+            while ((rewind->capacity - rewind->used) < total)
+            {
+                dmgl_rewind_drop(rewind);
+            }
+            dmgl_rewind_write(rewind, rewind->tail, &rewind->frame, sizeof (rewind->frame));
+            dmgl_rewind_write(rewind, rewind->tail + sizeof (uint32_t), &size, sizeof (size));
+            dmgl_rewind_write(rewind, rewind->tail + DMGL_REWIND_HEADER, rewind->delta, size);
+            dmgl_rewind_write(rewind, rewind->tail + DMGL_REWIND_HEADER + size, &size, sizeof (size));
+            rewind->tail = (rewind->tail + total) % rewind->capacity;
+            rewind->used += total;
+            ++rewind->count;
+        }
+    }
+    swap = rewind->state[0];
+    rewind->state[0] = rewind->state[1];
+    rewind->state[1] = swap;
+    rewind->frame = frame;
+    rewind->valid = true;
+}
+
+void dmgl_rewind_reset(dmgl_rewind_t *const rewind)
+{
+    rewind->valid = false;
+    rewind->count = 0;
+    rewind->head = 0;
+    rewind->tail = 0;
+    rewind->used = 0;
+}
+
+void dmgl_rewind_uninitialize(dmgl_rewind_t *const rewind)
+{
+    free(rewind->data);
+    free(rewind->delta);
+    free(rewind->state[0]);
+    free(rewind->state[1]);
+    memset(rewind, 0, sizeof (*rewind));
+}
@@ -0,0 +1,138 @@
+/*
+ * SPDX-FileCopyrightText: 2023 David Jolly <majestic53@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <common.h>
+
+typedef struct dmgl_rom_s
+{
+    uint8_t *data;
+    uint32_t count;
+    uint32_t length;
+    uint64_t hash;
+    dev_t device;
+    ino_t inode;
+    struct dmgl_rom_s *next;
+} dmgl_rom_t;
+
+static struct
+{
+    pthread_mutex_t lock;
+    dmgl_rom_t *head;
+} g_rom = { PTHREAD_MUTEX_INITIALIZER, NULL, };
+
+static dmgl_rom_t *dmgl_rom_find(const uint8_t *const data, uint32_t length)
+{
+    dmgl_rom_t *result = g_rom.head;
+    while (result && ((result->data != data) || (result->length != length)))
+    {
+        result = result->next;
+    }
+    return result;
+}
+
+uint64_t dmgl_rom_hash(const uint8_t *const data, uint32_t length)
+{
+    uint64_t result = 0;
+    dmgl_rom_t *rom = NULL;
+    pthread_mutex_lock(&g_rom.lock);
+    if ((rom = dmgl_rom_find(data, length)))
+    { /* MAPPED ROMS ARE HASHED ONCE, NOT ONCE PER INSTANCE */
+        if (!rom->hash)
+        {
+            rom->hash = dmgl_hash(DMGL_HASH, data, length);
+        }
+        result = rom->hash;
+    }
+    pthread_mutex_unlock(&g_rom.lock);
+    return rom ? result : dmgl_hash(DMGL_HASH, data, length);
+}
+
+int dmgl_rom_map(const char *const path, uint8_t **data, uint32_t *length)
+{
+    int file = -1, result = EXIT_SUCCESS;
+    dmgl_rom_t *rom = NULL;
+    struct stat status = {};
+    if (!path || !data || !length)
+    {
+        return DMGL_ERROR("Invalid rom path -- %p", path);
+    }
+    if ((file = open(path, O_RDONLY)) < 0)
+    {
+        return DMGL_ERROR("Failed to open rom -- %s", path);
+    }
+    if (fstat(file, &status) || !status.st_size || (status.st_size > UINT32_MAX))
+    {
+        close(file);
+        return DMGL_ERROR("Invalid rom length -- %s", path);
+    }
+    pthread_mutex_lock(&g_rom.lock);
+    for (rom = g_rom.head; rom; rom = rom->next)
+    {
+        if ((rom->device == status.st_dev) && (rom->inode == status.st_ino))
+        { /* SHARE THE EXISTING MAPPING */
+            ++rom->count;
+            break;
+        }
+    }
+    if (!rom)
+    {
+        if (!(rom = calloc(1, sizeof (*rom))))
+        {
+            result = DMGL_ERROR("Failed to allocate rom -- %zu bytes", sizeof (*rom));
+        }
+        else if ((rom->data = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, file, 0)) == MAP_FAILED)
+        {
+            free(rom);
+            rom = NULL;
+            result = DMGL_ERROR("Failed to map rom -- %s", path);
+        }
+        else
+        {
+            rom->count = 1;
+            rom->length = status.st_size;
+            rom->device = status.st_dev;
+            rom->inode = status.st_ino;
+            rom->next = g_rom.head;
+            g_rom.head = rom;
+        }
+    }
+    if (rom)
+    {
+        *data = rom->data;
+        *length = rom->length;
+    }
+    pthread_mutex_unlock(&g_rom.lock);
+    close(file);
+    return result;
+}
+
+int dmgl_rom_unmap(const uint8_t *const data)
+{
+    int result = EXIT_SUCCESS;
+    dmgl_rom_t **rom = &g_rom.head;
+    pthread_mutex_lock(&g_rom.lock);
+    while (*rom && ((*rom)->data != data))
+    {
+        rom = &(*rom)->next;
+    }
+    if (!*rom)
+    {
+        result = DMGL_ERROR("Invalid rom data -- %p", data);
+    }
+    else if (!--(*rom)->count)
+    {
+        dmgl_rom_t *unmapped = *rom;
+        *rom = unmapped->next;
+        munmap(unmapped->data, unmapped->length);
+        free(unmapped);
+    }
+    pthread_mutex_unlock(&g_rom.lock);
+    return result;
+}
@@ -0,0 +1,264 @@
+/*
+ * SPDX-FileCopyrightText: 2023 David Jolly <majestic53@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <common.h>
+
+#define DMGL_SAMPLER_UNNAMED 0x80000000 /* FRAMES WITHOUT A SYMBOL KEEP THEIR (BANK << 16) | ADDRESS */
+
+typedef struct
+{
+    uint32_t key;
+    char *name;
+} dmgl_sampler_symbol_t;
+
+typedef struct
+{
+    uint64_t hash;
+    uint64_t cycles;
+    uint32_t *frame;
+    uint32_t depth;
+} dmgl_sampler_entry_t;
+
+struct dmgl_sampler_s
+{
+    struct
+    {
+        dmgl_sampler_symbol_t *data;
+        uint32_t capacity;
+        uint32_t count;
+    } symbol;
+    struct
+    {
+        dmgl_sampler_entry_t *data;
+        uint32_t capacity;
+        uint32_t count;
+    } stack;
+};
+
+static uint8_t dmgl_sampler_region(uint16_t address)
+{
+    return (address < 0x4000) ? 0 : ((address < 0x8000) ? 1 : 2);
+}
+
+static uint32_t dmgl_sampler_key(uint16_t bank, uint16_t address)
+{ /* ONLY ROM AND CARTRIDGE RAM ARE BANKED ON THE DMG */
+    return ((address >= 0xC000) ? 0 : (bank << 16)) | address;
+}
+
+static int dmgl_sampler_comparator(const void *first, const void *second)
+{
+    const dmgl_sampler_symbol_t *left = first, *right = second;
+    return (left->key > right->key) - (left->key < right->key);
+}
+
+static uint32_t dmgl_sampler_find(const dmgl_sampler_t *const sampler, uint32_t key)
+{
+    uint32_t begin = 0, end = sampler->symbol.count;
+    while (begin < end)
+    { /* THE LAST SYMBOL AT OR BEFORE THE KEY */
+        uint32_t middle = begin + ((end - begin) / 2);
+        if (sampler->symbol.data[middle].key <= key)
+        {
+            begin = middle + 1;
+        }
+        else
+        {
+            end = middle;
+        }
+    }
+    if (begin && ((sampler->symbol.data[begin - 1].key >> 16) == (key >> 16))
+            && (dmgl_sampler_region(sampler->symbol.data[begin - 1].key) == dmgl_sampler_region(key)))
+    {
+        return begin - 1;
+    }
+    return DMGL_SAMPLER_UNNAMED | key;
+}
+
+static int dmgl_sampler_grow(dmgl_sampler_t *const sampler)
+{
+    dmgl_sampler_entry_t *data = NULL;
+    uint32_t capacity = sampler->stack.capacity ? (2 * sampler->stack.capacity) : 1024;
+    if (!(data = calloc(capacity, sizeof (*data))))
+    {
+        return DMGL_ERROR("Failed to allocate sampler -- %zu bytes", capacity * sizeof (*data));
+    }
+    for (uint32_t index = 0; index < sampler->stack.capacity; ++index)
+    { /* REHASH EVERY STACK INTO THE LARGER TABLE */
+        const dmgl_sampler_entry_t *entry = &sampler->stack.data[index];
+        if (entry->frame)
+        {
+            uint32_t slot = entry->hash & (capacity - 1);
+            while (data[slot].frame)
+            {
+                slot = (slot + 1) & (capacity - 1);
+            }
+            data[slot] = *entry;
+        }
+    }
+    free(sampler->stack.data);
+    sampler->stack.data = data;
+    sampler->stack.capacity = capacity;
+    return EXIT_SUCCESS;
+}
+
+static int dmgl_sampler_load(dmgl_sampler_t *const sampler, const char *const path)
+{
+    FILE *file = NULL;
+    char line[512] = {};
+    if (!(file = fopen(path, "r")))
+    {
+        return DMGL_ERROR("Failed to open symbols -- %s", path);
+    }
+    while (fgets(line, sizeof (line), file))
+    {
+        char name[256] = {};
+        unsigned bank = 0, address = 0;
+        if ((sscanf(line, " %x:%x %255s", &bank, &address, name) != 3) || (address > 0xFFFF) || strchr(name, '.'))
+        { /* COMMENTS, AND LOCAL LABELS, WHICH ARE CHARGED TO THEIR ENCLOSING FUNCTION */
+            continue;
+        }
+        if (sampler->symbol.count == sampler->symbol.capacity)
+        {
+            dmgl_sampler_symbol_t *data = NULL;
+            uint32_t capacity = sampler->symbol.capacity ? (2 * sampler->symbol.capacity) : 1024;
+            if (!(data = realloc(sampler->symbol.data, capacity * sizeof (*data))))
+            {
+                fclose(file);
+                return DMGL_ERROR("Failed to allocate symbols -- %zu bytes", capacity * sizeof (*data));
+            }
+            sampler->symbol.data = data;
+            sampler->symbol.capacity = capacity;
+        }
+        if (!(sampler->symbol.data[sampler->symbol.count].name = strdup(name)))
+        {
+            fclose(file);
+            return DMGL_ERROR("Failed to allocate symbol -- %s", name);
+        }
+        sampler->symbol.data[sampler->symbol.count++].key = dmgl_sampler_key(bank, address);
+    }
+    fclose(file);
+    qsort(sampler->symbol.data, sampler->symbol.count, sizeof (*sampler->symbol.data), dmgl_sampler_comparator);
+    return EXIT_SUCCESS;
+}
+
+static void dmgl_sampler_name(const dmgl_sampler_t *const sampler, uint32_t frame, FILE *file)
+{
+    if (frame & DMGL_SAMPLER_UNNAMED)
+    {
+        fprintf(file, "%02X:%04X", (frame >> 16) & 0x7FFF, frame & 0xFFFF);
+    }
+    else
+    {
+        fprintf(file, "%s", sampler->symbol.data[frame].name);
+    }
+}
+
+void dmgl_sampler_add(dmgl_sampler_t *const sampler, const uint32_t *const frame, uint32_t depth, uint32_t location, uint32_t cycles)
+{
+    uint32_t count = 0, slot = 0, stack[66] = {};
+    uint64_t hash = DMGL_HASH;
+    dmgl_sampler_entry_t *entry = NULL;
+    for (uint32_t index = 0; (index < depth) && (count < 65); ++index)
+    {
+        stack[count++] = dmgl_sampler_find(sampler, frame[index]);
+    }
+    location = dmgl_sampler_find(sampler, location);
+    if ((!(location & DMGL_SAMPLER_UNNAMED) || !count) && (!count || (stack[count - 1] != location)))
+    { /* WITHOUT A SYMBOL, CODE INSIDE A CALLED FUNCTION IS CHARGED TO THAT FUNCTION */
+        stack[count++] = location;
+    }
+    hash = dmgl_hash(hash, (const uint8_t *)stack, count * sizeof (*stack));
+    if (((sampler->stack.count + 1) * 2) > sampler->stack.capacity)
+    {
+        if (dmgl_sampler_grow(sampler) != EXIT_SUCCESS)
+        {
+            return;
+        }
+    }
+    slot = hash & (sampler->stack.capacity - 1);
+    while ((entry = &sampler->stack.data[slot])->frame)
+    {
+        if ((entry->hash == hash) && (entry->depth == count) && !memcmp(entry->frame, stack, count * sizeof (*stack)))
+        {
+            entry->cycles += cycles;
+            return;
+        }
+        slot = (slot + 1) & (sampler->stack.capacity - 1);
+    }
+    if (!(entry->frame = malloc(count * sizeof (*stack))))
+    {
+        DMGL_ERROR("Failed to allocate sample -- %zu bytes", count * sizeof (*stack));
+        return;
+    }
+    memcpy(entry->frame, stack, count * sizeof (*stack));
+    entry->cycles = cycles;
+    entry->depth = count;
+    entry->hash = hash;
+    ++sampler->stack.count;
+}
+
+dmgl_sampler_t *dmgl_sampler_create(const char *const symbols)
+{
+    dmgl_sampler_t *result = NULL;
+    if (!(result = calloc(1, sizeof (*result))))
+    {
+        DMGL_ERROR("Failed to allocate sampler -- %zu bytes", sizeof (*result));
+        return NULL;
+    }
+    if ((symbols && (dmgl_sampler_load(result, symbols) != EXIT_SUCCESS)) || (dmgl_sampler_grow(result) != EXIT_SUCCESS))
+    {
+        dmgl_sampler_destroy(result);
+        return NULL;
+    }
+    return result;
+}
+
+void dmgl_sampler_destroy(dmgl_sampler_t *const sampler)
+{
+    if (sampler)
+    {
+        for (uint32_t index = 0; index < sampler->stack.capacity; ++index)
+        {
+            free(sampler->stack.data[index].frame);
+        }
+        for (uint32_t index = 0; index < sampler->symbol.count; ++index)
+        {
+            free(sampler->symbol.data[index].name);
+        }
+        free(sampler->stack.data);
+        free(sampler->symbol.data);
+        free(sampler);
+    }
+}
+
+int dmgl_sampler_write(const dmgl_sampler_t *const sampler, const char *const path)
+{
+    FILE *file = NULL;
+    if (!(file = fopen(path, "w")))
+    {
+        return DMGL_ERROR("Failed to open profile -- %s", path);
+    }
+    for (uint32_t index = 0; index < sampler->stack.capacity; ++index)
+    { /* FOLDED STACKS: OUTERMOST FRAME FIRST, THEN THE CYCLES SPENT THERE */
+        const dmgl_sampler_entry_t *entry = &sampler->stack.data[index];
+        if (entry->frame)
+        {
+            for (uint32_t frame = 0; frame < entry->depth; ++frame)
+            {
+                if (frame)
+                {
+                    fputc(';', file);
+                }
+                dmgl_sampler_name(sampler, entry->frame[frame], file);
+            }
+            fprintf(file, " %llu\n", (unsigned long long)entry->cycles);
+        }
+    }
+    if (fclose(file))
+    {
+        return DMGL_ERROR("Failed to write profile -- %s", path);
+    }
+    return EXIT_SUCCESS;
+}
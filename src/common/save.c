@@ -0,0 +1,166 @@
+/*
+ * SPDX-FileCopyrightText: 2023 David Jolly <majestic53@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <common.h>
+
+#define DMGL_SAVE_LENGTH (17 * 0x2000) /* HEADER + 16 RAM BANKS */
+
+typedef struct dmgl_save_file_s
+{
+    uint8_t *data;
+    uint32_t length;
+    bool busy;
+    bool pending;
+    struct dmgl_save_file_s *next;
+} dmgl_save_file_t;
+
+static struct
+{
+    bool started;
+    bool threaded;
+    pthread_cond_t done;
+    pthread_cond_t wake;
+    pthread_mutex_t lock;
+    pthread_t thread;
+    dmgl_save_file_t *head;
+} g_save = { false, false, PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER, PTHREAD_MUTEX_INITIALIZER, };
+
+static dmgl_save_file_t *dmgl_save_find(const uint8_t *const data)
+{
+    dmgl_save_file_t *result = g_save.head;
+    while (result && (result->data != data))
+    {
+        result = result->next;
+    }
+    return result;
+}
+
+static void *dmgl_save_flusher(void *argument)
+{
+    pthread_mutex_lock(&g_save.lock);
+    for (;;)
+    {
+        dmgl_save_file_t *file = g_save.head;
+        while (file && !file->pending)
+        {
+            file = file->next;
+        }
+        if (!file)
+        {
+            pthread_cond_wait(&g_save.wake, &g_save.lock);
+            continue;
+        }
+        file->busy = true;
+        file->pending = false;
+        pthread_mutex_unlock(&g_save.lock);
+        msync(file->data, file->length, MS_SYNC); /* ONLY PAGES DIRTIED SINCE THE LAST FLUSH ARE WRITTEN */
+        pthread_mutex_lock(&g_save.lock);
+        file->busy = false;
+        pthread_cond_broadcast(&g_save.done);
+    }
+    return NULL;
+}
+
+int dmgl_save_map(const char *const path, uint8_t **data, uint32_t *length)
+{
+    int file = -1, result = EXIT_SUCCESS;
+    dmgl_save_file_t *save = NULL;
+    struct stat status = {};
+    if (!path || !data || !length)
+    {
+        return DMGL_ERROR("Invalid save path -- %p", path);
+    }
+    if ((file = open(path, O_RDWR | O_CREAT, 0644)) < 0)
+    {
+        return DMGL_ERROR("Failed to open save -- %s", path);
+    }
+    if (fstat(file, &status) || (status.st_size > UINT32_MAX))
+    {
+        close(file);
+        return DMGL_ERROR("Invalid save length -- %s", path);
+    }
+    if ((status.st_size < DMGL_SAVE_LENGTH) && ftruncate(file, DMGL_SAVE_LENGTH))
+    { /* NEW AND SHORT FILES ARE ZERO-FILLED TO THE LARGEST CARTRIDGE RAM */
+        close(file);
+        return DMGL_ERROR("Failed to resize save -- %s", path);
+    }
+    if (!(save = calloc(1, sizeof (*save))))
+    {
+        close(file);
+        return DMGL_ERROR("Failed to allocate save -- %zu bytes", sizeof (*save));
+    }
+    save->length = (status.st_size < DMGL_SAVE_LENGTH) ? DMGL_SAVE_LENGTH : status.st_size;
+    if ((save->data = mmap(NULL, save->length, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0)) == MAP_FAILED)
+    {
+        free(save);
+        close(file);
+        return DMGL_ERROR("Failed to map save -- %s", path);
+    }
+    close(file);
+    pthread_mutex_lock(&g_save.lock);
+    if (!g_save.started)
+    { /* WITHOUT THREAD SUPPORT (WASM) SAVES ARE SYNCED ON THE CALLING THREAD */
+        g_save.started = true;
+        if ((g_save.threaded = !pthread_create(&g_save.thread, NULL, dmgl_save_flusher, NULL)))
+        {
+            pthread_detach(g_save.thread);
+        }
+    }
+    save->next = g_save.head;
+    g_save.head = save;
+    pthread_mutex_unlock(&g_save.lock);
+    *data = save->data;
+    *length = save->length;
+    return result;
+}
+
+void dmgl_save_sync(const uint8_t *const data)
+{
+    dmgl_save_file_t *save = NULL;
+    pthread_mutex_lock(&g_save.lock);
+    if ((save = dmgl_save_find(data)))
+    {
+        if (g_save.threaded)
+        {
+            save->pending = true;
+            pthread_cond_signal(&g_save.wake);
+        }
+        else
+        {
+            msync(save->data, save->length, MS_SYNC);
+        }
+    }
+    pthread_mutex_unlock(&g_save.lock);
+}
+
+int dmgl_save_unmap(const uint8_t *const data)
+{
+    dmgl_save_file_t **save = &g_save.head, *unmapped = NULL;
+    pthread_mutex_lock(&g_save.lock);
+    while (*save && ((*save)->data != data))
+    {
+        save = &(*save)->next;
+    }
+    if (!(unmapped = *save))
+    {
+        pthread_mutex_unlock(&g_save.lock);
+        return DMGL_ERROR("Invalid save data -- %p", data);
+    }
+    while (unmapped->busy)
+    {
+        pthread_cond_wait(&g_save.done, &g_save.lock);
+    }
+    *save = unmapped->next;
+    pthread_mutex_unlock(&g_save.lock);
+    msync(unmapped->data, unmapped->length, MS_SYNC);
+    munmap(unmapped->data, unmapped->length);
+    free(unmapped);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,128 @@
+/*
+ * SPDX-FileCopyrightText: 2023 David Jolly <majestic53@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <common.h>
+
+static uint64_t dmgl_state_read_value(dmgl_state_t *const state, uint8_t length)
+{
+    uint64_t result = 0;
+    if ((state->offset + length) > state->length)
+    {
+        state->overflow = true;
+        return result;
+    }
+    for (uint8_t index = 0; index < length; ++index)
+    { /* LITTLE-ENDIAN */
+        result |= (uint64_t)state->data[state->offset++] << (8 * index);
+    }
+    return result;
+}
+
+static void dmgl_state_write_value(dmgl_state_t *const state, uint64_t value, uint8_t length)
+{
+    if (state->data)
+    {
+        if ((state->offset + length) > state->length)
+        {
+            state->overflow = true;
+            return;
+        }
+        for (uint8_t index = 0; index < length; ++index)
+        { /* LITTLE-ENDIAN */
+            state->data[state->offset + index] = value >> (8 * index);
+        }
+    }
+    state->offset += length;
+}
+
+void dmgl_state_read(dmgl_state_t *const state, void *const data, uint32_t length)
+{
+    if ((state->offset + length) > state->length)
+    {
+        state->overflow = true;
+        return;
+    }
+    memcpy(data, state->data + state->offset, length);
+    state->offset += length;
+}
+
+uint8_t dmgl_state_read_8(dmgl_state_t *const state)
+{
+    return dmgl_state_read_value(state, sizeof (uint8_t));
+}
+
+uint16_t dmgl_state_read_16(dmgl_state_t *const state)
+{
+    return dmgl_state_read_value(state, sizeof (uint16_t));
+}
+
+uint32_t dmgl_state_read_32(dmgl_state_t *const state)
+{
+    return dmgl_state_read_value(state, sizeof (uint32_t));
+}
+
+uint64_t dmgl_state_read_64(dmgl_state_t *const state)
+{
+    return dmgl_state_read_value(state, sizeof (uint64_t));
+}
+
+float dmgl_state_read_float(dmgl_state_t *const state)
+{
+    float result = 0.f;
+    uint32_t value = dmgl_state_read_32(state);
+    memcpy(&result, &value, sizeof (result));
+    return result;
+}
+
+void dmgl_state_skip(dmgl_state_t *const state, uint32_t length)
+{
+    if ((state->offset + length) > state->length)
+    {
+        state->overflow = true;
+        return;
+    }
+    state->offset += length;
+}
+
+void dmgl_state_write(dmgl_state_t *const state, const void *const data, uint32_t length)
+{
+    if (state->data)
+    {
+        if ((state->offset + length) > state->length)
+        {
+            state->overflow = true;
+            return;
+        }
+        memcpy(state->data + state->offset, data, length);
+    }
+    state->offset += length;
+}
+
+void dmgl_state_write_8(dmgl_state_t *const state, uint8_t value)
+{
+    dmgl_state_write_value(state, value, sizeof (value));
+}
+
+void dmgl_state_write_16(dmgl_state_t *const state, uint16_t value)
+{
+    dmgl_state_write_value(state, value, sizeof (value));
+}
+
+void dmgl_state_write_32(dmgl_state_t *const state, uint32_t value)
+{
+    dmgl_state_write_value(state, value, sizeof (value));
+}
+
+void dmgl_state_write_64(dmgl_state_t *const state, uint64_t value)
+{
+    dmgl_state_write_value(state, value, sizeof (value));
+}
+
+void dmgl_state_write_float(dmgl_state_t *const state, float value)
+{
+    uint32_t result = 0;
+    memcpy(&result, &value, sizeof (result));
+    dmgl_state_write_32(state, result);
+}
@@ -0,0 +1,359 @@
+/*
+ * SPDX-FileCopyrightText: 2023 David Jolly <majestic53@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <pthread.h>
+#include <common.h>
+
+/*
+ * TRACE LAYOUT (LITTLE-ENDIAN)
+ * 0x00: MAGIC ("dmt")
+ * 0x04: VERSION
+ * 0x08: CHUNKS, EACH A RECORD COUNT, A BYTE LENGTH AND THE ENCODED RECORDS
+ *
+ * RECORDS ARE PACKED TO 28 BYTES AND ENCODED AGAINST THE RECORD BEFORE THEM: THE CYCLE AS A DIFFERENCE,
+ * EVERY OTHER BYTE XORED. EACH RECORD IS THEN A 32-BIT MASK OF ITS NON-ZERO BYTES, FOLLOWED BY THOSE BYTES.
+ * EVERY CHUNK STARTS FROM A ZEROED RECORD, SO CHUNKS DECODE ON THEIR OWN.
+ */
+
+#define DMGL_TRACER_CHUNK 4096 /* RECORDS */
+#define DMGL_TRACER_CHUNKS 16
+#define DMGL_TRACER_RECORD 28 /* BYTES */
+#define DMGL_TRACER_VERSION 1
+
+struct dmgl_trace_reader_s
+{
+    int result;
+    FILE *file;
+    uint32_t count;
+    uint32_t index;
+    uint32_t length;
+    uint32_t offset;
+    uint64_t cycle;
+    uint8_t previous[DMGL_TRACER_RECORD];
+    uint8_t data[DMGL_TRACER_CHUNK * (DMGL_TRACER_RECORD + 4)];
+};
+
+struct dmgl_tracer_s
+{
+    bool stopped;
+    bool threaded;
+    int result;
+    FILE *file;
+    pthread_cond_t done;
+    pthread_cond_t wake;
+    pthread_mutex_t lock;
+    pthread_t thread;
+    uint32_t count;
+    uint32_t head; /* CHUNKS FILLED BY THE EMULATOR */
+    uint32_t tail; /* CHUNKS WRITTEN TO DISK */
+    uint8_t buffer[DMGL_TRACER_CHUNK * (DMGL_TRACER_RECORD + 4)];
+    dmgl_trace_t chunk[DMGL_TRACER_CHUNKS][DMGL_TRACER_CHUNK];
+};
+
+static void dmgl_tracer_pack(uint8_t *const data, const dmgl_trace_t *const trace)
+{
+    const uint16_t word[] = { trace->bank, trace->pc, trace->af, trace->bc, trace->de, trace->hl, trace->sp, };
+    for (uint8_t index = 0; index < 8; ++index)
+    {
+        data[index] = trace->cycle >> (index * 8);
+    }
+    for (uint8_t index = 0; index < (sizeof (word) / sizeof (*word)); ++index)
+    {
+        data[8 + (index * 2)] = word[index];
+        data[9 + (index * 2)] = word[index] >> 8;
+    }
+    memcpy(data + 22, trace->opcode, sizeof (trace->opcode));
+    data[25] = trace->interrupt.enabled;
+    data[26] = trace->interrupt.enable;
+    data[27] = trace->interrupt.flag;
+}
+
+static void dmgl_tracer_unpack(dmgl_trace_t *const trace, const uint8_t *const data)
+{
+    uint16_t word[7] = {};
+    trace->cycle = 0;
+    for (uint8_t index = 0; index < 8; ++index)
+    {
+        trace->cycle |= (uint64_t)data[index] << (index * 8);
+    }
+    for (uint8_t index = 0; index < (sizeof (word) / sizeof (*word)); ++index)
+    {
+        word[index] = data[8 + (index * 2)] | (data[9 + (index * 2)] << 8);
+    }
+    trace->bank = word[0];
+    trace->pc = word[1];
+    trace->af = word[2];
+    trace->bc = word[3];
+    trace->de = word[4];
+    trace->hl = word[5];
+    trace->sp = word[6];
+    memcpy(trace->opcode, data + 22, sizeof (trace->opcode));
+    trace->interrupt.enabled = data[25];
+    trace->interrupt.enable = data[26];
+    trace->interrupt.flag = data[27];
+}
+
+static uint32_t dmgl_tracer_encode(uint8_t *const data, const dmgl_trace_t *const trace, uint32_t count)
+{
+    uint32_t result = 0;
+    uint64_t cycle = 0;
+    uint8_t previous[DMGL_TRACER_RECORD] = {};
+    for (uint32_t index = 0; index < count; ++index)
+    {
+        uint32_t mask = 0, offset = result + 4;
+        uint8_t current[DMGL_TRACER_RECORD] = {}, delta[DMGL_TRACER_RECORD] = {};
+        dmgl_trace_t entry = trace[index];
+        entry.cycle -= cycle;
+        cycle = trace[index].cycle;
+        dmgl_tracer_pack(current, &entry);
+        for (uint8_t byte = 0; byte < DMGL_TRACER_RECORD; ++byte)
+        { /* THE CYCLE IS ALREADY A DIFFERENCE, SO ONLY THE REST IS XORED */
+            delta[byte] = (byte < 8) ? current[byte] : (current[byte] ^ previous[byte]);
+            if (delta[byte])
+            {
+                mask |= 1 << byte;
+                data[offset++] = delta[byte];
+            }
+        }
+        memcpy(previous, current, sizeof (previous));
+        for (uint8_t byte = 0; byte < 4; ++byte)
+        {
+            data[result + byte] = mask >> (byte * 8);
+        }
+        result = offset;
+    }
+    return result;
+}
+
+static int dmgl_tracer_flush(dmgl_tracer_t *const tracer, const dmgl_trace_t *const trace, uint32_t count)
+{
+    uint32_t length = dmgl_tracer_encode(tracer->buffer, trace, count);
+    uint8_t header[8] = { count, count >> 8, count >> 16, count >> 24, length, length >> 8, length >> 16, length >> 24, };
+    if ((fwrite(header, sizeof (*header), sizeof (header), tracer->file) != sizeof (header))
+            || (fwrite(tracer->buffer, sizeof (*tracer->buffer), length, tracer->file) != length))
+    {
+        return DMGL_ERROR("Failed to write trace -- %u records", count);
+    }
+    return EXIT_SUCCESS;
+}
+
+static void *dmgl_tracer_writer(void *argument)
+{
+    dmgl_tracer_t *const tracer = argument;
+    pthread_mutex_lock(&tracer->lock);
+    for (;;)
+    {
+        uint32_t tail = tracer->tail;
+        if (tail == __atomic_load_n(&tracer->head, __ATOMIC_ACQUIRE))
+        {
+            if (tracer->stopped)
+            {
+                break;
+            }
+            pthread_cond_wait(&tracer->wake, &tracer->lock);
+            continue;
+        }
+        pthread_mutex_unlock(&tracer->lock);
+        if ((dmgl_tracer_flush(tracer, tracer->chunk[tail % DMGL_TRACER_CHUNKS], DMGL_TRACER_CHUNK) != EXIT_SUCCESS)
+                && (tracer->result == EXIT_SUCCESS))
+        { /* LATER CHUNKS ARE STILL DRAINED, SO THE EMULATOR NEVER WAITS ON A FAILED WRITER */
+            tracer->result = EXIT_FAILURE;
+        }
+        pthread_mutex_lock(&tracer->lock);
+        __atomic_store_n(&tracer->tail, tail + 1, __ATOMIC_RELEASE);
+        pthread_cond_signal(&tracer->done);
+    }
+    pthread_mutex_unlock(&tracer->lock);
+    return NULL;
+}
+
+static void dmgl_tracer_publish(dmgl_tracer_t *const tracer)
+{
+    uint32_t head = tracer->head + 1;
+    if (!tracer->threaded)
+    { /* WITHOUT THREAD SUPPORT (WASM) CHUNKS ARE WRITTEN ON THE CALLING THREAD */
+        if (dmgl_tracer_flush(tracer, tracer->chunk[0], DMGL_TRACER_CHUNK) != EXIT_SUCCESS)
+        {
+            tracer->result = EXIT_FAILURE;
+        }
+        return;
+    }
+    pthread_mutex_lock(&tracer->lock);
+    __atomic_store_n(&tracer->head, head, __ATOMIC_RELEASE);
+    pthread_cond_signal(&tracer->wake);
+    while ((head - __atomic_load_n(&tracer->tail, __ATOMIC_ACQUIRE)) == DMGL_TRACER_CHUNKS)
+    { /* THE RING IS FULL, SO WAIT RATHER THAN DROP RECORDS */
+        pthread_cond_wait(&tracer->done, &tracer->lock);
+    }
+    pthread_mutex_unlock(&tracer->lock);
+}
+
+int dmgl_trace_close(dmgl_trace_reader_t *const reader)
+{
+    int result = EXIT_SUCCESS;
+    if (reader)
+    {
+        result = reader->result;
+        fclose(reader->file);
+        free(reader);
+    }
+    return result;
+}
+
+uint32_t dmgl_trace_next(dmgl_trace_reader_t *const reader, dmgl_trace_t *const trace)
+{
+    uint32_t mask = 0;
+    uint8_t current[DMGL_TRACER_RECORD] = {};
+    if (!reader || !trace || (reader->result != EXIT_SUCCESS))
+    {
+        return 0;
+    }
+    if (reader->index == reader->count)
+    {
+        uint8_t header[8] = {};
+        size_t length = fread(header, sizeof (*header), sizeof (header), reader->file);
+        if (!length)
+        { /* END OF TRACE */
+            return 0;
+        }
+        reader->count = header[0] | (header[1] << 8) | (header[2] << 16) | ((uint32_t)header[3] << 24);
+        reader->length = header[4] | (header[5] << 8) | (header[6] << 16) | ((uint32_t)header[7] << 24);
+        if ((length != sizeof (header)) || !reader->count || (reader->count > DMGL_TRACER_CHUNK) || (reader->length > sizeof (reader->data))
+                || (fread(reader->data, sizeof (*reader->data), reader->length, reader->file) != reader->length))
+        {
+            reader->result = DMGL_ERROR("Invalid trace chunk -- %u records", reader->count);
+            return 0;
+        }
+        memset(reader->previous, 0, sizeof (reader->previous));
+        reader->cycle = 0;
+        reader->index = 0;
+        reader->offset = 0;
+    }
+    if ((reader->offset + 4) <= reader->length)
+    {
+        mask = reader->data[reader->offset] | (reader->data[reader->offset + 1] << 8) | (reader->data[reader->offset + 2] << 16)
+            | ((uint32_t)reader->data[reader->offset + 3] << 24);
+    }
+    if (((reader->offset + 4) > reader->length) || ((reader->offset + 4 + __builtin_popcount(mask)) > reader->length))
+    {
+        reader->result = DMGL_ERROR("Truncated trace chunk -- %u bytes", reader->length);
+        return 0;
+    }
+    reader->offset += 4;
+    for (uint8_t byte = 0; byte < DMGL_TRACER_RECORD; ++byte)
+    {
+        uint8_t delta = (mask & (1 << byte)) ? reader->data[reader->offset++] : 0;
+        current[byte] = (byte < 8) ? delta : (reader->previous[byte] ^ delta);
+    }
+    memcpy(reader->previous, current, sizeof (reader->previous));
+    dmgl_tracer_unpack(trace, current);
+    trace->cycle = (reader->cycle += trace->cycle);
+    ++reader->index;
+    return 1;
+}
+
+dmgl_trace_reader_t *dmgl_trace_open(const char *const path)
+{
+    uint8_t header[8] = {};
+    dmgl_trace_reader_t *result = NULL;
+    if (!path)
+    {
+        DMGL_ERROR("Invalid trace path -- %p", path);
+        return NULL;
+    }
+    if (!(result = calloc(1, sizeof (*result))))
+    {
+        DMGL_ERROR("Failed to allocate trace reader -- %zu bytes", sizeof (*result));
+        return NULL;
+    }
+    if (!(result->file = fopen(path, "rb")))
+    {
+        DMGL_ERROR("Failed to open trace -- %s", path);
+        free(result);
+        return NULL;
+    }
+    if ((fread(header, sizeof (*header), sizeof (header), result->file) != sizeof (header)) || strncmp((const char *)header, "dmt", 4))
+    {
+        DMGL_ERROR("Invalid trace magic -- %s", path);
+        dmgl_trace_close(result);
+        return NULL;
+    }
+    if (header[4] != DMGL_TRACER_VERSION)
+    {
+        DMGL_ERROR("Unsupported trace version -- %u", header[4]);
+        dmgl_trace_close(result);
+        return NULL;
+    }
+    return result;
+}
+
+dmgl_tracer_t *dmgl_tracer_create(const char *const path)
+{
+    dmgl_tracer_t *result = NULL;
+    const uint8_t header[8] = { 'd', 'm', 't', 0, DMGL_TRACER_VERSION, };
+    if (!(result = calloc(1, sizeof (*result))))
+    {
+        DMGL_ERROR("Failed to allocate tracer -- %zu bytes", sizeof (*result));
+        return NULL;
+    }
+    if (!(result->file = fopen(path, "wb")))
+    {
+        DMGL_ERROR("Failed to open trace -- %s", path);
+        free(result);
+        return NULL;
+    }
+    if (fwrite(header, sizeof (*header), sizeof (header), result->file) != sizeof (header))
+    {
+        DMGL_ERROR("Failed to write trace -- %s", path);
+        fclose(result->file);
+        free(result);
+        return NULL;
+    }
+    pthread_cond_init(&result->done, NULL);
+    pthread_cond_init(&result->wake, NULL);
+    pthread_mutex_init(&result->lock, NULL);
+    result->threaded = !pthread_create(&result->thread, NULL, dmgl_tracer_writer, result);
+    return result;
+}
+
+int dmgl_tracer_destroy(dmgl_tracer_t *const tracer)
+{
+    int result = EXIT_SUCCESS;
+    if (!tracer)
+    {
+        return result;
+    }
+    if (tracer->threaded)
+    {
+        pthread_mutex_lock(&tracer->lock);
+        tracer->stopped = true;
+        pthread_cond_signal(&tracer->wake);
+        pthread_mutex_unlock(&tracer->lock);
+        pthread_join(tracer->thread, NULL);
+    }
+    if (tracer->count && (dmgl_tracer_flush(tracer, tracer->chunk[tracer->threaded ? (tracer->head % DMGL_TRACER_CHUNKS) : 0], tracer->count) != EXIT_SUCCESS))
+    {
+        tracer->result = EXIT_FAILURE;
+    }
+    if (fclose(tracer->file) || (tracer->result != EXIT_SUCCESS))
+    {
+        result = DMGL_ERROR("Failed to write trace");
+    }
+    pthread_cond_destroy(&tracer->done);
+    pthread_cond_destroy(&tracer->wake);
+    pthread_mutex_destroy(&tracer->lock);
+    free(tracer);
+    return result;
+}
+
+void dmgl_tracer_push(dmgl_tracer_t *const tracer, const dmgl_trace_t *const trace)
+{ /* ONLY THE EMULATOR THREAD WRITES THE CURRENT CHUNK, SO RECORDS ARE STORED WITHOUT A LOCK */
+    tracer->chunk[tracer->threaded ? (tracer->head % DMGL_TRACER_CHUNKS) : 0][tracer->count] = *trace;
+    if (++tracer->count == DMGL_TRACER_CHUNK)
+    {
+        dmgl_tracer_publish(tracer);
+        tracer->count = 0;
+    }
+}
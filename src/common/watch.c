@@ -0,0 +1,112 @@
+/*
+ * SPDX-FileCopyrightText: 2023 David Jolly <majestic53@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <common.h>
+
+struct dmgl_watch_s
+{
+    char **name;
+    dmgl_range_t *range;
+    uint32_t capacity;
+    uint32_t count;
+    uint32_t length;
+};
+
+int dmgl_watch_add(dmgl_watch_t *const watch, const char *const name, uint16_t address, uint16_t length)
+{
+    char *copy = NULL;
+    if (!watch || !name)
+    {
+        return DMGL_ERROR("Invalid watch -- %p", watch);
+    }
+    if (!length || ((address + length) > 0x10000))
+    {
+        return DMGL_ERROR("Invalid watch range -- %04X (%u bytes)", address, length);
+    }
+    if (dmgl_watch_offset(watch, name) != UINT32_MAX)
+    {
+        return DMGL_ERROR("Duplicate watch -- %s", name);
+    }
+    if (watch->count == watch->capacity)
+    {
+        char **names = NULL;
+        dmgl_range_t *ranges = NULL;
+        uint32_t capacity = watch->capacity ? (2 * watch->capacity) : 16;
+        if (!(names = realloc(watch->name, capacity * sizeof (*names))))
+        {
+            return DMGL_ERROR("Failed to allocate watch -- %zu bytes", capacity * sizeof (*names));
+        }
+        watch->name = names;
+        if (!(ranges = realloc(watch->range, capacity * sizeof (*ranges))))
+        {
+            return DMGL_ERROR("Failed to allocate watch -- %zu bytes", capacity * sizeof (*ranges));
+        }
+        watch->range = ranges;
+        watch->capacity = capacity;
+    }
+    if (!(copy = malloc(strlen(name) + 1)))
+    {
+        return DMGL_ERROR("Failed to allocate watch -- %zu bytes", strlen(name) + 1);
+    }
+    strcpy(copy, name);
+    watch->name[watch->count] = copy;
+    watch->range[watch->count].address = address;
+    watch->range[watch->count].length = length;
+    watch->length += length;
+    ++watch->count;
+    return EXIT_SUCCESS;
+}
+
+dmgl_watch_t *dmgl_watch_create(void)
+{
+    dmgl_watch_t *result = NULL;
+    if (!(result = calloc(1, sizeof (*result))))
+    {
+        DMGL_ERROR("Failed to allocate watch -- %zu bytes", sizeof (*result));
+    }
+    return result;
+}
+
+void dmgl_watch_destroy(dmgl_watch_t *const watch)
+{
+    if (watch)
+    {
+        for (uint32_t index = 0; index < watch->count; ++index)
+        {
+            free(watch->name[index]);
+        }
+        free(watch->name);
+        free(watch->range);
+        free(watch);
+    }
+}
+
+uint32_t dmgl_watch_gather(const dmgl_watch_t *const watch, dmgl_instance_t *const instance, uint8_t *const data)
+{
+    if (!watch || !watch->count)
+    {
+        return 0;
+    }
+    return dmgl_gather(instance, watch->range, watch->count, data);
+}
+
+uint32_t dmgl_watch_length(const dmgl_watch_t *const watch)
+{
+    return watch ? watch->length : 0;
+}
+
+uint32_t dmgl_watch_offset(const dmgl_watch_t *const watch, const char *const name)
+{
+    uint32_t result = 0;
+    for (uint32_t index = 0; watch && name && (index < watch->count); ++index)
+    {
+        if (!strcmp(watch->name[index], name))
+        {
+            return result;
+        }
+        result += watch->range[index].length;
+    }
+    return UINT32_MAX;
+}
@@ -11,9 +11,42 @@
 #include <timer.h>
 #include <video.h>
 
-static struct
+struct dmgl_instance_s
 {
+    uint64_t cycle;
+    uint64_t hash;
+    uint64_t ram;
+    uint32_t flush;
+    uint32_t frame;
     dmgl_t *context;
+    dmgl_movie_t movie;
+    dmgl_rewind_t rewind;
+    dmgl_coverage_t *coverage;
+    dmgl_heatmap_t *heatmap;
+    dmgl_tracer_t *tracer;
+#ifdef DMGL_PROFILE
+    dmgl_sampler_t *sampler;
+#endif /* DMGL_PROFILE */
+    struct
+    {
+        dmgl_break_t *entry;
+        uint8_t *start;
+        uint32_t capacity;
+        uint32_t count;
+        uint8_t (*address)[0x2000];
+        uint8_t (*write)[0x2000];
+        const uint8_t (*active)[0x2000];
+        uint32_t opcode;
+        uint64_t resume;
+        bool hit;
+        dmgl_stop_t stop;
+    } breakpoint;
+    struct
+    {
+        dmgl_telemetry_t live;
+        dmgl_telemetry_t published;
+        uint32_t sequence;
+    } telemetry;
     dmgl_audio_t audio;
     dmgl_input_t input;
     dmgl_memory_t memory;
@@ -21,24 +54,199 @@ static struct
     dmgl_serial_t serial;
     dmgl_timer_t timer;
     dmgl_video_t video;
-} g_dmgl = {};
+};
+
+static const struct
+{
+    uint16_t address;
+    uint8_t value;
+} BOOT[] =
+{
+    { 0xFF26, 0xF1, }, /* NR52 (FIRST, SO THE OTHER AUDIO WRITES LAND) */
+    { 0xFF10, 0x80, }, { 0xFF11, 0xBF, }, { 0xFF12, 0xF3, }, { 0xFF13, 0xFF, }, { 0xFF14, 0xBF, }, /* NR10-NR14 */
+    { 0xFF16, 0x3F, }, { 0xFF17, 0x00, }, { 0xFF18, 0xFF, }, { 0xFF19, 0xBF, }, /* NR21-NR24 */
+    { 0xFF1A, 0x7F, }, { 0xFF1B, 0xFF, }, { 0xFF1C, 0x9F, }, { 0xFF1D, 0xFF, }, { 0xFF1E, 0xBF, }, /* NR30-NR34 */
+    { 0xFF20, 0xFF, }, { 0xFF21, 0x00, }, { 0xFF22, 0x00, }, { 0xFF23, 0xBF, }, /* NR41-NR44 */
+    { 0xFF24, 0x77, }, { 0xFF25, 0xF3, }, /* NR50-NR51 */
+    { 0xFF00, 0xCF, }, /* P1 */
+    { 0xFF01, 0x00, }, { 0xFF02, 0x7E, }, /* SB, SC */
+    { 0xFF05, 0x00, }, { 0xFF06, 0x00, }, { 0xFF07, 0xF8, }, /* TIMA, TMA, TAC */
+    { 0xFF40, 0x91, }, { 0xFF41, 0x85, }, { 0xFF42, 0x00, }, { 0xFF43, 0x00, }, { 0xFF45, 0x00, }, /* LCDC, STAT, SCY, SCX, LYC */
+    { 0xFF47, 0xFC, }, { 0xFF48, 0xFF, }, { 0xFF49, 0xFF, }, { 0xFF4A, 0x00, }, { 0xFF4B, 0x00, }, /* BGP, OBP0, OBP1, WY, WX */
+    { 0xFF0F, 0xE1, }, { 0xFFFF, 0x00, }, /* IF, IE */
+    { 0xFF50, 0x01, }, /* BOOTROM DISABLE */
+};
+
+typedef struct
+{
+    dmgl_instance_t *const *instance;
+    const uint8_t *action;
+    const dmgl_batch_t *batch;
+    uint32_t frame;
+    uint32_t ram;
+} dmgl_batch_job_t;
+
+static __thread dmgl_instance_t *g_dmgl = NULL;
+
+static uint64_t dmgl_now(void)
+{
+    struct timespec now = {};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec * 1000000000ULL) + now.tv_nsec;
+}
+
+static uint8_t dmgl_region(uint16_t address)
+{
+    uint8_t result = DMGL_REGION_IO;
+    switch (address)
+    {
+        case 0x0000 ... 0x7FFF: /* ROM */
+            result = DMGL_REGION_ROM;
+            break;
+        case 0x8000 ... 0x9FFF: /* VIDEO RAM */
+            result = DMGL_REGION_VIDEO;
+            break;
+        case 0xA000 ... 0xBFFF: /* CARTRIDGE RAM */
+            result = DMGL_REGION_CARTRIDGE;
+            break;
+        case 0xC000 ... 0xFDFF: /* WORK RAM */
+            result = DMGL_REGION_WORK;
+            break;
+        case 0xFE00 ... 0xFEFF: /* OBJECT RAM */
+            result = DMGL_REGION_OBJECT;
+            break;
+        case 0xFF80 ... 0xFFFE: /* HIGH RAM */
+            result = DMGL_REGION_HIGH;
+            break;
+        default:
+            break;
+    }
+    return result;
+}
+
+static bool dmgl_bootrom(uint16_t address)
+{
+    return g_dmgl->memory.bootrom.enabled && (address < 0x0100);
+}
+
+static void dmgl_boot(void)
+{
+    for (uint32_t index = 0; index < (sizeof (BOOT) / sizeof (*BOOT)); ++index)
+    {
+        dmgl_write(BOOT[index].address, BOOT[index].value);
+    }
+    g_dmgl->processor.af.word = 0x01B0;
+    g_dmgl->processor.bc.word = 0x0013;
+    g_dmgl->processor.de.word = 0x00D8;
+    g_dmgl->processor.hl.word = 0x014D;
+    g_dmgl->processor.sp.word = 0xFFFE;
+    g_dmgl->processor.pc.word = 0x0100;
+    g_dmgl->timer.divider = 0xABCC; /* DIV READS 0xAB */
+}
+
+static bool dmgl_break_compare(const dmgl_break_t *const entry, uint8_t value, uint8_t start)
+{
+    bool result = false;
+    uint8_t mask = entry->compare.mask ? entry->compare.mask : 0xFF;
+    switch (entry->compare.type)
+    {
+        case DMGL_COMPARE_ANY:
+            result = true;
+            break;
+        case DMGL_COMPARE_EQUAL:
+            result = ((value & mask) == (entry->compare.value & mask));
+            break;
+        case DMGL_COMPARE_NOT_EQUAL:
+            result = ((value & mask) != (entry->compare.value & mask));
+            break;
+        case DMGL_COMPARE_LESS:
+            result = ((value & mask) < (entry->compare.value & mask));
+            break;
+        case DMGL_COMPARE_GREATER:
+            result = ((value & mask) > (entry->compare.value & mask));
+            break;
+        case DMGL_COMPARE_CHANGED:
+            result = ((value & mask) != (start & mask));
+            break;
+        default:
+            break;
+    }
+    return result;
+}
+
+static bool dmgl_break_address(uint16_t address)
+{
+    for (uint32_t index = 0; index < g_dmgl->breakpoint.count; ++index)
+    {
+        const dmgl_break_t *entry = &g_dmgl->breakpoint.entry[index];
+        if ((entry->type == DMGL_BREAK_ADDRESS) && (entry->address == address)
+                && ((entry->bank == DMGL_BANK_ANY) || (entry->bank == dmgl_memory_bank(&g_dmgl->memory, address))))
+        {
+            g_dmgl->breakpoint.stop.index = index;
+            g_dmgl->breakpoint.stop.address = address;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool dmgl_break_opcode(uint16_t address)
+{
+    uint8_t opcode = dmgl_peek(address);
+    for (uint32_t index = 0; index < g_dmgl->breakpoint.count; ++index)
+    {
+        const dmgl_break_t *entry = &g_dmgl->breakpoint.entry[index];
+        if ((entry->type == DMGL_BREAK_OPCODE) && dmgl_break_compare(entry, opcode, opcode))
+        {
+            g_dmgl->breakpoint.stop.index = index;
+            g_dmgl->breakpoint.stop.address = address;
+            g_dmgl->breakpoint.stop.value = opcode;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void dmgl_break_write(uint16_t address, uint8_t value)
+{
+    for (uint32_t index = 0; !g_dmgl->breakpoint.hit && (index < g_dmgl->breakpoint.count); ++index)
+    {
+        const dmgl_break_t *entry = &g_dmgl->breakpoint.entry[index];
+        if ((entry->type == DMGL_BREAK_WRITE) && (entry->address == address)
+                && ((entry->bank == DMGL_BANK_ANY) || (entry->bank == dmgl_memory_bank(&g_dmgl->memory, address)))
+                && dmgl_break_compare(entry, value, g_dmgl->breakpoint.start[index]))
+        {
+            g_dmgl->breakpoint.hit = true;
+            g_dmgl->breakpoint.stop.index = index;
+            g_dmgl->breakpoint.stop.address = address;
+            g_dmgl->breakpoint.stop.value = value;
+        }
+    }
+}
 
 static void dmgl_clock(void)
 {
-    while (!dmgl_video_clock(&g_dmgl.video))
+    uint64_t begin = dmgl_now(), cycle = g_dmgl->cycle;
+    while (!dmgl_video_clock(&g_dmgl->video))
     {
-        dmgl_audio_clock(&g_dmgl.audio);
-        dmgl_input_clock(&g_dmgl.input);
-        dmgl_serial_clock(&g_dmgl.serial);
-        dmgl_timer_clock(&g_dmgl.timer);
-        dmgl_processor_clock(&g_dmgl.processor);
+        if (g_dmgl->cycle == g_dmgl->movie.next)
+        {
+            dmgl_movie_cycle(&g_dmgl->movie, g_dmgl->cycle, dmgl_input_state(&g_dmgl->input));
+        }
+        ++g_dmgl->cycle;
+        dmgl_audio_clock(&g_dmgl->audio);
+        dmgl_input_clock(&g_dmgl->input);
+        dmgl_serial_clock(&g_dmgl->serial);
+        dmgl_timer_clock(&g_dmgl->timer);
+        dmgl_processor_clock(&g_dmgl->processor);
     }
-    dmgl_memory_clock(&g_dmgl.memory);
+    dmgl_memory_clock(&g_dmgl->memory);
+    g_dmgl->telemetry.live.cycle += g_dmgl->cycle - cycle;
+    g_dmgl->telemetry.live.host.emulate += dmgl_now() - begin;
 }
 
 static int dmgl_initialize(dmgl_t *const context)
 {
-    int result = EXIT_SUCCESS;
     if (!context)
     {
         return DMGL_ERROR("Invalid context -- %p", context);
@@ -63,54 +271,270 @@ static int dmgl_initialize(dmgl_t *const context)
     {
         return DMGL_ERROR("Invalid uninitialize callback -- %p", context->client.uninitialize);
     }
-    g_dmgl.context = context;
-    if ((result = dmgl_memory_initialize(&g_dmgl.memory, g_dmgl.context)) != EXIT_SUCCESS)
+    return EXIT_SUCCESS;
+}
+
+static void dmgl_instance_attach(dmgl_instance_t *const instance)
+{ /* COUNTERS BELONG TO THE INSTANCE, NOT THE MACHINE STATE, SO FORKS START FROM ZERO AND RESETS KEEP COUNTING */
+    instance->audio.telemetry = &instance->telemetry.live;
+    instance->memory.telemetry = &instance->telemetry.live;
+    instance->processor.telemetry = &instance->telemetry.live;
+    instance->video.telemetry = &instance->telemetry.live;
+}
+
+static void dmgl_instance_fork(dmgl_instance_t *const instance, const dmgl_instance_t *const parent)
+{
+    instance->cycle = parent->cycle;
+    instance->hash = parent->hash;
+    instance->ram = parent->ram;
+    instance->flush = parent->frame;
+    instance->frame = parent->frame;
+    memcpy(&instance->input, &parent->input, sizeof (parent->input));
+    memcpy(&instance->processor, &parent->processor, sizeof (parent->processor));
+    memcpy(&instance->serial, &parent->serial, sizeof (parent->serial));
+    memcpy(&instance->timer, &parent->timer, sizeof (parent->timer));
+    dmgl_audio_fork(&instance->audio, &parent->audio);
+    dmgl_memory_fork(&instance->memory, &parent->memory);
+    dmgl_video_fork(&instance->video, &parent->video);
+    dmgl_instance_attach(instance);
+}
+
+static int dmgl_instance_initialize(dmgl_instance_t *const instance, dmgl_t *const context)
+{
+    int result = EXIT_SUCCESS;
+    instance->context = context;
+    dmgl_instance_attach(instance);
+    if ((result = dmgl_memory_initialize(&instance->memory, instance->context)) != EXIT_SUCCESS)
+    {
+        return result;
+    }
+    if ((result = dmgl_video_initialize(&instance->video)) != EXIT_SUCCESS)
+    {
+        return result;
+    }
+    instance->hash = dmgl_rom_hash(instance->context->rom.data, instance->context->rom.length);
+    instance->ram = DMGL_HASH;
+    for (uint32_t index = 0; index < instance->memory.ram.count; ++index)
+    { /* THE CACHE KEY AND MOVIE COVER CARTRIDGE RAM ONLY, SINCE THE CLOCK IN THE SAVE HEADER ALWAYS MOVES */
+        instance->ram = dmgl_hash(instance->ram, instance->memory.ram.bank[index]->data, sizeof (instance->memory.ram.bank[index]->data));
+    }
+    if ((result = dmgl_movie_initialize(&instance->movie, instance->context, instance->hash, instance->ram)) != EXIT_SUCCESS)
     {
         return result;
     }
-    if ((result = g_dmgl.context->client.initialize(dmgl_memory_title(&g_dmgl.memory), g_dmgl.context->scale)) != EXIT_SUCCESS)
+    g_dmgl = instance;
+    if (instance->movie.playing ? instance->movie.skip : instance->context->bootrom.skip)
+    { /* START AT 0x0100 WITH THE REGISTERS THE BOOTROM LEAVES BEHIND */
+        dmgl_boot();
+    }
+    if (instance->context->cache.path && !instance->movie.playing && !instance->movie.recording)
+    { /* A MISSING OR STALE CACHE FALLS BACK TO A COLD START */
+        dmgl_cache_read(instance->context->cache.path, dmgl_memory_checksum_global(&instance->memory), instance->ram);
+    }
+    if ((result = dmgl_rewind_initialize(&instance->rewind, instance->context, dmgl_state_length())) != EXIT_SUCCESS)
     {
-        return DMGL_ERROR("Client initialize failed -- %08X", result);
+        return result;
     }
-    g_dmgl.context->client.input = dmgl_input;
     return EXIT_SUCCESS;
 }
 
 static int dmgl_poll(void)
 {
+    bool ignored[8] = {};
     int result = EXIT_SUCCESS;
-    if ((result = g_dmgl.context->client.poll(dmgl_input_state(&g_dmgl.input))) != EXIT_SUCCESS)
+    uint64_t begin = dmgl_now();
+    bool (*state)[8] = dmgl_input_state(&g_dmgl->input);
+    if (g_dmgl->context->client.poll && ((result = g_dmgl->context->client.poll(g_dmgl->movie.playing ? &ignored : state)) != EXIT_SUCCESS))
     {
         result = DMGL_ERROR("Client poll failed -- %08X", result);
     }
+    else if (!dmgl_movie_frame(&g_dmgl->movie, g_dmgl->cycle, state))
+    { /* MOVIE COMPLETE */
+        result = EXIT_FAILURE;
+    }
+    g_dmgl->telemetry.live.host.poll += dmgl_now() - begin;
     return result;
 }
 
 static int dmgl_sync(void)
 {
     int result = EXIT_SUCCESS;
-    if ((result = g_dmgl.context->client.sync(dmgl_video_color(&g_dmgl.video), g_dmgl.context->palette, dmgl_audio_sample(&g_dmgl.audio))) != EXIT_SUCCESS)
+    uint64_t begin = dmgl_now();
+    if (g_dmgl->context->client.sync && ((result = g_dmgl->context->client.sync(dmgl_video_color(&g_dmgl->video), g_dmgl->context->palette, dmgl_audio_sample(&g_dmgl->audio))) != EXIT_SUCCESS))
     {
         result = DMGL_ERROR("Client sync failed -- %08X", result);
     }
+    g_dmgl->telemetry.live.host.sync += dmgl_now() - begin;
     return result;
 }
 
-static void dmgl_uninitialize(void)
+static void dmgl_state(dmgl_state_t *const state)
+{
+    dmgl_state_write(state, "sta", 4);
+    dmgl_state_write_32(state, DMGL_STATE);
+    dmgl_state_write_64(state, g_dmgl->hash);
+    dmgl_state_write_64(state, g_dmgl->cycle);
+    dmgl_audio_state_save(&g_dmgl->audio, state);
+    dmgl_input_state_save(&g_dmgl->input, state);
+    dmgl_memory_state_save(&g_dmgl->memory, state);
+    dmgl_processor_state_save(&g_dmgl->processor, state);
+    dmgl_serial_state_save(&g_dmgl->serial, state);
+    dmgl_timer_state_save(&g_dmgl->timer, state);
+    dmgl_video_state_save(&g_dmgl->video, state);
+}
+
+static bool dmgl_state_check(dmgl_state_t state)
+{ /* A READ-ONLY PASS ON A COPY OF THE CURSOR. FIXED-SIZE COMPONENTS ARE SKIPPED BY THEIR SAVED LENGTH */
+    dmgl_state_t length = {};
+    dmgl_state_skip(&state, sizeof (uint64_t)); /* CYCLE */
+    dmgl_audio_state_save(&g_dmgl->audio, &length);
+    dmgl_input_state_save(&g_dmgl->input, &length);
+    dmgl_state_skip(&state, length.offset);
+    dmgl_memory_state_check(&g_dmgl->memory, &state);
+    length.offset = 0;
+    dmgl_processor_state_save(&g_dmgl->processor, &length);
+    dmgl_serial_state_save(&g_dmgl->serial, &length);
+    dmgl_timer_state_save(&g_dmgl->timer, &length);
+    dmgl_state_skip(&state, length.offset);
+    dmgl_video_state_check(&g_dmgl->video, &state);
+    return !state.overflow && (state.offset == state.length);
+}
+
+static void dmgl_capture(void)
+{
+    uint8_t *data = NULL;
+    if ((data = dmgl_rewind_pending(&g_dmgl->rewind, g_dmgl->frame)))
+    {
+        dmgl_state_t state = { .data = data, .length = g_dmgl->rewind.length, };
+        dmgl_state(&state);
+        dmgl_rewind_push(&g_dmgl->rewind, g_dmgl->frame);
+    }
+}
+
+static void dmgl_capture_trace(dmgl_trace_t *const trace)
+{
+    const dmgl_processor_t *const processor = &g_dmgl->processor;
+    trace->cycle = g_dmgl->cycle;
+    trace->bank = dmgl_memory_bank(&g_dmgl->memory, processor->pc.word);
+    trace->pc = processor->pc.word;
+    trace->af = processor->af.word;
+    trace->bc = processor->bc.word;
+    trace->de = processor->de.word;
+    trace->hl = processor->hl.word;
+    trace->sp = processor->sp.word;
+    trace->interrupt.enabled = processor->interrupt.enabled;
+    trace->interrupt.enable = processor->interrupt.enable;
+    trace->interrupt.flag = processor->interrupt.flag;
+    for (uint8_t index = 0; index < sizeof (trace->opcode); ++index)
+    { /* BUS READS HAVE NO SIDE EFFECTS, SO PEEKING PAST THE OPCODE IS SAFE */
+        trace->opcode[index] = dmgl_peek(processor->pc.word + index);
+    }
+}
+
+static void dmgl_flush(void)
+{
+    dmgl_memory_t *const memory = &g_dmgl->memory;
+    if (!memory->save || !memory->ram.dirty)
+    {
+        memory->ram.flush = false;
+        return;
+    }
+    if (memory->ram.flush || (g_dmgl->context->ram.interval && ((g_dmgl->frame - g_dmgl->flush) >= g_dmgl->context->ram.interval)))
+    { /* COPY DIRTY BANKS INTO THE SAVE DATA, THEN LET THE FLUSHER WRITE THEM BACK */
+        dmgl_memory_flush(memory);
+        dmgl_save_sync((const uint8_t *)memory->save);
+        g_dmgl->flush = g_dmgl->frame;
+    }
+}
+
+static void dmgl_publish(void)
+{ /* A SEQUENCE LOCK: READERS RETRY WHILE THE SEQUENCE IS ODD, OR IF IT MOVED WHILE THEY COPIED */
+    const uint64_t *source = (const uint64_t *)&g_dmgl->telemetry.live;
+    uint64_t *destination = (uint64_t *)&g_dmgl->telemetry.published;
+    uint32_t sequence = g_dmgl->telemetry.sequence;
+    __atomic_store_n(&g_dmgl->telemetry.sequence, sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    for (uint32_t index = 0; index < (sizeof (dmgl_telemetry_t) / sizeof (uint64_t)); ++index)
+    {
+        __atomic_store_n(&destination[index], source[index], __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&g_dmgl->telemetry.sequence, sequence + 2, __ATOMIC_RELEASE);
+}
+
+static void dmgl_frame(void)
 {
-    if (g_dmgl.context->client.uninitialize)
+    dmgl_telemetry_t *const telemetry = &g_dmgl->telemetry.live;
+    uint64_t begin = dmgl_now(), end = 0;
+    ++g_dmgl->frame;
+    dmgl_capture();
+    end = dmgl_now();
+    dmgl_flush();
+    telemetry->host.capture += end - begin;
+    telemetry->host.flush += dmgl_now() - end;
+    ++telemetry->frame;
+    dmgl_publish();
+}
+
+static void dmgl_batch_observe(const dmgl_batch_job_t *const job, uint32_t index)
+{
+    uint8_t *ram = NULL;
+    const dmgl_batch_t *const batch = job->batch;
+    if (batch->frame.data)
+    { /* THE VIDEO RENDERS THE DOWNSAMPLED FRAMES, SO THIS IS ONLY A COPY OF THE STACK */
+        dmgl_video_observation(&g_dmgl->video, batch->frame.data + (index * job->frame));
+    }
+    if (batch->ram.data)
     {
-        g_dmgl.context->client.uninitialize();
+        ram = batch->ram.data + (index * job->ram);
+        dmgl_gather(g_dmgl, batch->ram.range, batch->ram.count, ram);
+    }
+    if (batch->reward.data)
+    {
+        batch->reward.data[index] = batch->reward.callback(ram, ram ? job->ram : 0, batch->reward.argument);
     }
 }
 
+static void dmgl_batch_step(uint32_t index, void *argument)
+{
+    const dmgl_batch_job_t *const job = argument;
+    bool (*state)[8] = dmgl_input_state(&job->instance[index]->input);
+    g_dmgl = job->instance[index];
+    for (uint8_t button = 0; button < 8; ++button)
+    {
+        (*state)[button] = ((job->action[index] & (1 << button)) == (1 << button));
+    }
+    for (uint32_t frame = 0; frame < job->batch->frames; ++frame)
+    {
+        if (!dmgl_movie_frame(&g_dmgl->movie, g_dmgl->cycle, state))
+        { /* MOVIE COMPLETE */
+            break;
+        }
+        dmgl_clock();
+        dmgl_frame();
+    }
+    dmgl_batch_observe(job, index);
+}
+
 int dmgl(dmgl_t *const context)
 {
     int result = EXIT_SUCCESS;
+    dmgl_instance_t *instance = NULL;
     if ((result = dmgl_initialize(context)) != EXIT_SUCCESS)
     {
         return result;
     }
+    if (!(instance = dmgl_create(context)))
+    {
+        return EXIT_FAILURE;
+    }
+    if ((result = context->client.initialize(dmgl_memory_title(&instance->memory), context->scale)) != EXIT_SUCCESS)
+    {
+        result = DMGL_ERROR("Client initialize failed -- %08X", result);
+        dmgl_destroy(instance);
+        return result;
+    }
+    context->client.input = dmgl_input;
+    g_dmgl = instance;
     while (dmgl_poll() == EXIT_SUCCESS)
     {
         dmgl_clock();
@@ -118,14 +542,685 @@ int dmgl(dmgl_t *const context)
         {
             break;
         }
+        dmgl_frame();
     }
-    dmgl_uninitialize();
+    context->client.uninitialize();
+    dmgl_destroy(instance);
     return result;
 }
 
+int dmgl_batch(dmgl_instance_t *const *const instance, const uint8_t *const action, uint32_t count, const dmgl_batch_t *const batch)
+{
+    dmgl_instance_t *current = NULL;
+    dmgl_batch_job_t job = { .instance = instance, .action = action, .batch = batch, };
+    if (!instance || !action || !batch)
+    {
+        return DMGL_ERROR("Invalid batch -- %p", batch);
+    }
+    for (uint32_t index = 0; index < count; ++index)
+    {
+        if (!instance[index])
+        {
+            return DMGL_ERROR("Invalid instance -- %u", index);
+        }
+    }
+    if (batch->frame.data && (!batch->frame.width || (batch->frame.width > 160) || !batch->frame.height || (batch->frame.height > 144)))
+    {
+        return DMGL_ERROR("Invalid batch frame size -- %ux%u", batch->frame.width, batch->frame.height);
+    }
+    if (batch->ram.data && (!batch->ram.range || !batch->ram.count))
+    {
+        return DMGL_ERROR("Invalid batch ram ranges -- %p", batch->ram.range);
+    }
+    if (batch->reward.data && !batch->reward.callback)
+    {
+        return DMGL_ERROR("Invalid batch reward callback -- %p", batch->reward.callback);
+    }
+    for (uint32_t index = 0; batch->frame.data && (index < count); ++index)
+    { /* INSTANCES ALREADY OBSERVING AT THIS SIZE KEEP THEIR STACKS */
+        if (dmgl_video_observe(&instance[index]->video, batch->frame.width, batch->frame.height, batch->frame.stack ? batch->frame.stack : 1) != EXIT_SUCCESS)
+        {
+            return EXIT_FAILURE;
+        }
+    }
+    job.frame = batch->frame.width * batch->frame.height * (batch->frame.stack ? batch->frame.stack : 1);
+    for (uint32_t range = 0; batch->ram.data && (range < batch->ram.count); ++range)
+    {
+        job.ram += batch->ram.range[range].length;
+    }
+    current = g_dmgl;
+    dmgl_batch_run(count, batch->threads, dmgl_batch_step, &job);
+    g_dmgl = current;
+    return EXIT_SUCCESS;
+}
+
+int dmgl_break_add(dmgl_instance_t *const instance, const dmgl_break_t *const condition)
+{
+    uint8_t (**bitmap)[0x2000] = NULL;
+    if (!instance || !condition)
+    {
+        return DMGL_ERROR("Invalid break -- %p", condition);
+    }
+    if ((condition->type > DMGL_BREAK_OPCODE) || (condition->compare.type > DMGL_COMPARE_CHANGED))
+    {
+        return DMGL_ERROR("Invalid break type -- %u", condition->type);
+    }
+    if (instance->breakpoint.count == instance->breakpoint.capacity)
+    {
+        uint8_t *start = NULL;
+        dmgl_break_t *entry = NULL;
+        uint32_t capacity = instance->breakpoint.capacity ? (2 * instance->breakpoint.capacity) : 16;
+        if (!(entry = realloc(instance->breakpoint.entry, capacity * sizeof (*entry))))
+        {
+            return DMGL_ERROR("Failed to allocate break -- %zu bytes", capacity * sizeof (*entry));
+        }
+        instance->breakpoint.entry = entry; /* THE OLD ARRAY IS GONE, BUT THE CAPACITY ONLY GROWS ONCE BOTH ARRAYS HAVE */
+        if (!(start = realloc(instance->breakpoint.start, capacity * sizeof (*start))))
+        {
+            return DMGL_ERROR("Failed to allocate break -- %zu bytes", capacity * sizeof (*start));
+        }
+        instance->breakpoint.start = start;
+        instance->breakpoint.capacity = capacity;
+    }
+    if (condition->type != DMGL_BREAK_OPCODE)
+    {
+        bitmap = (condition->type == DMGL_BREAK_ADDRESS) ? &instance->breakpoint.address : &instance->breakpoint.write;
+        if (!*bitmap && !(*bitmap = calloc(1, sizeof (**bitmap))))
+        { /* BITMAPS ARE ONLY ALLOCATED ONCE A BREAK OF THEIR TYPE EXISTS, SO RUNS WITHOUT ONE SKIP THE CHECK */
+            return DMGL_ERROR("Failed to allocate break bitmap -- %zu bytes", sizeof (**bitmap));
+        }
+    }
+    if (condition->type != DMGL_BREAK_WRITE)
+    { /* THESE ARE CHECKED ON INSTRUCTION BOUNDARIES, SO A PENDING PAIR IS SPLIT BACK INTO ITS TWO */
+        dmgl_processor_unfuse(&instance->processor);
+    }
+    if (condition->type == DMGL_BREAK_OPCODE)
+    { /* OPCODES ARE NOT TIED TO AN ADDRESS, SO EVERY INSTRUCTION IS CHECKED WHILE ONE EXISTS. ONLY THE MATCHING OPCODES STAY UNFUSED */
+        for (uint32_t opcode = 0; opcode < 256; ++opcode)
+        {
+            if (dmgl_break_compare(condition, opcode, opcode))
+            {
+                instance->processor.unfused[opcode >> 3] |= (1 << (opcode & 7));
+            }
+        }
+        ++instance->breakpoint.opcode;
+    }
+    else if (condition->type == DMGL_BREAK_ADDRESS)
+    { /* ANY INSTRUCTION CAN SIT AT THE ADDRESS, SO NOTHING IS FUSED */
+        instance->processor.stepped = true;
+    }
+    else
+    {
+        (**bitmap)[condition->address >> 3] |= (1 << (condition->address & 7));
+    }
+    instance->breakpoint.entry[instance->breakpoint.count++] = *condition;
+    return EXIT_SUCCESS;
+}
+
+void dmgl_break_clear(dmgl_instance_t *const instance)
+{
+    if (instance)
+    {
+        free(instance->breakpoint.entry);
+        free(instance->breakpoint.start);
+        free(instance->breakpoint.address);
+        free(instance->breakpoint.write);
+        memset(&instance->breakpoint, 0, sizeof (instance->breakpoint));
+        memset(instance->processor.unfused, 0, sizeof (instance->processor.unfused));
+        instance->processor.stepped = (instance->heatmap != NULL);
+    }
+}
+
+int dmgl_cache_save(void)
+{
+    if (!g_dmgl)
+    {
+        return DMGL_ERROR("Invalid instance -- %p", g_dmgl);
+    }
+    if (!g_dmgl->context->cache.path)
+    {
+        return DMGL_ERROR("Invalid cache path -- %p", g_dmgl->context->cache.path);
+    }
+    return dmgl_cache_write(g_dmgl->context->cache.path, dmgl_memory_checksum_global(&g_dmgl->memory), g_dmgl->ram);
+}
+
+uint8_t dmgl_coverage(const dmgl_instance_t *const instance, uint16_t bank, uint16_t address)
+{
+    if (!instance || !instance->coverage)
+    {
+        DMGL_ERROR("Invalid coverage -- %p", instance ? (void *)instance->coverage : NULL);
+        return 0;
+    }
+    return (address < 0x8000) ? dmgl_coverage_test(instance->coverage, bank, address) : 0;
+}
+
+dmgl_instance_t *dmgl_create(dmgl_t *const context)
+{
+    dmgl_instance_t *result = NULL;
+    if (!context)
+    {
+        DMGL_ERROR("Invalid context -- %p", context);
+        return NULL;
+    }
+    if (!(result = calloc(1, sizeof (*result))))
+    {
+        DMGL_ERROR("Failed to allocate instance -- %zu bytes", sizeof (*result));
+        return NULL;
+    }
+    if (dmgl_instance_initialize(result, context) != EXIT_SUCCESS)
+    {
+        dmgl_destroy(result);
+        return NULL;
+    }
+    if (context->profile.interval)
+    { /* FORKS ARE NEVER SAMPLED, ONLY THE INSTANCE CREATED FROM THE CONTEXT */
+#ifdef DMGL_PROFILE
+        if (!(result->sampler = dmgl_sampler_create(context->profile.symbols)))
+        {
+            dmgl_destroy(result);
+            return NULL;
+        }
+        result->processor.profile.countdown = context->profile.interval;
+#else
+        DMGL_ERROR("Profiling not built (define DMGL_PROFILE) -- %u", context->profile.interval);
+        dmgl_destroy(result);
+        return NULL;
+#endif /* DMGL_PROFILE */
+    }
+    if (context->trace.path)
+    { /* LIKE SAMPLING, ONLY THE INSTANCE CREATED FROM THE CONTEXT IS TRACED */
+        if (!(result->tracer = dmgl_tracer_create(context->trace.path)))
+        {
+            dmgl_destroy(result);
+            return NULL;
+        }
+        result->processor.traced = true;
+    }
+    if (context->heatmap.path)
+    { /* EXECUTES ARE COUNTED FROM THE TRACE HOOK, SO THE INSTANCE IS TRACED EVEN WITHOUT A TRACER */
+        if (!(result->heatmap = dmgl_heatmap_create(result->memory.rom.count, result->memory.ram.count)))
+        {
+            dmgl_destroy(result);
+            return NULL;
+        }
+        result->processor.stepped = true; /* AN UNDONE PAIR WOULD COUNT THE READS OF ITS SECOND HALF TWICE */
+        result->processor.traced = true;
+    }
+    if (context->coverage.path)
+    { /* OPCODES ARE MARKED FROM THE TRACE HOOK, LIKE THE HEATMAP */
+        if (!(result->coverage = dmgl_coverage_create(context->coverage.path, dmgl_memory_checksum_global(&result->memory), result->memory.rom.count)))
+        {
+            dmgl_destroy(result);
+            return NULL;
+        }
+        result->processor.traced = true;
+    }
+    return result;
+}
+
+void dmgl_destroy(dmgl_instance_t *const instance)
+{
+    if (instance)
+    {
+#ifdef DMGL_PROFILE
+        if (instance->sampler)
+        {
+            if (instance->context->profile.path && (dmgl_sampler_write(instance->sampler, instance->context->profile.path) != EXIT_SUCCESS))
+            {
+                DMGL_ERROR("Failed to write profile -- %s", instance->context->profile.path);
+            }
+            dmgl_sampler_destroy(instance->sampler);
+        }
+#endif /* DMGL_PROFILE */
+        if (instance->coverage)
+        {
+            if (dmgl_coverage_write(instance->coverage, instance->context->coverage.path) != EXIT_SUCCESS)
+            {
+                DMGL_ERROR("Failed to write coverage -- %s", instance->context->coverage.path);
+            }
+            dmgl_coverage_destroy(instance->coverage);
+        }
+        if (instance->heatmap)
+        {
+            if (dmgl_heatmap_write(instance->heatmap, instance->context->heatmap.path) != EXIT_SUCCESS)
+            {
+                DMGL_ERROR("Failed to write heatmap -- %s", instance->context->heatmap.path);
+            }
+            dmgl_heatmap_destroy(instance->heatmap);
+        }
+        if (dmgl_tracer_destroy(instance->tracer) != EXIT_SUCCESS)
+        {
+            DMGL_ERROR("Failed to write trace -- %s", instance->context->trace.path);
+        }
+        dmgl_break_clear(instance);
+        dmgl_movie_uninitialize(&instance->movie);
+        dmgl_rewind_uninitialize(&instance->rewind);
+        dmgl_audio_uninitialize(&instance->audio);
+        dmgl_memory_uninitialize(&instance->memory);
+        dmgl_video_uninitialize(&instance->video);
+        if (g_dmgl == instance)
+        {
+            g_dmgl = NULL;
+        }
+        free(instance);
+    }
+}
+
+int dmgl_digest(dmgl_instance_t *const instance, dmgl_digest_t *const digest)
+{
+    const uint8_t (*color)[160][144] = NULL;
+    if (!instance || !digest)
+    {
+        return DMGL_ERROR("Invalid digest -- %p", digest);
+    }
+    if (!(color = dmgl_video_color(&instance->video)))
+    { /* THE COLOR BUFFER IS ALLOCATED ON FIRST USE, SO IT STAYS BLANK UNTIL THE NEXT FRAME */
+        return EXIT_FAILURE;
+    }
+    digest->cycle = instance->cycle;
+    digest->color = dmgl_hash(DMGL_HASH, (const uint8_t *)color, sizeof (*color));
+    digest->vram = dmgl_hash(DMGL_HASH, instance->video.ram->data, sizeof (instance->video.ram->data));
+    digest->wram = dmgl_hash(DMGL_HASH, instance->memory.ram.work->data, sizeof (instance->memory.ram.work->data));
+    return EXIT_SUCCESS;
+}
+
+uint32_t dmgl_gather(dmgl_instance_t *const instance, const dmgl_range_t *const range, uint32_t count, uint8_t *const data)
+{
+    uint32_t result = 0;
+    dmgl_instance_t *current = g_dmgl;
+    if (!instance || !range || !data)
+    {
+        DMGL_ERROR("Invalid gather -- %p", range);
+        return 0;
+    }
+    g_dmgl = instance;
+    for (uint32_t index = 0; index < count; ++index)
+    {
+        const uint8_t *view = NULL;
+        if ((view = dmgl_memory_view(&instance->memory, range[index].address, range[index].length)))
+        {
+            memcpy(data + result, view, range[index].length);
+            result += range[index].length;
+        }
+        else
+        { /* RANGES OUTSIDE RAM, OR ACROSS A REGION BOUNDARY, GO THROUGH THE BUS */
+            for (uint32_t offset = 0; offset < range[index].length; ++offset)
+            {
+                data[result++] = dmgl_peek(range[index].address + offset);
+            }
+        }
+    }
+    g_dmgl = current;
+    return result;
+}
+
+dmgl_instance_t *dmgl_fork(const dmgl_instance_t *const instance)
+{
+    dmgl_instance_t *result = NULL;
+    if (!instance)
+    {
+        DMGL_ERROR("Invalid instance -- %p", instance);
+        return NULL;
+    }
+    if (!(result = calloc(1, sizeof (*result))))
+    {
+        DMGL_ERROR("Failed to allocate instance -- %zu bytes", sizeof (*result));
+        return NULL;
+    }
+    result->context = instance->context;
+    result->movie.next = UINT64_MAX; /* FORKS NEVER PLAY OR RECORD */
+    dmgl_instance_fork(result, instance);
+    memset(result->processor.unfused, 0, sizeof (result->processor.unfused)); /* FORKS HAVE NO BREAKS */
+    result->processor.stepped = false;
+    result->processor.traced = false;
+#ifdef DMGL_PROFILE
+    result->processor.profile.countdown = 0;
+#endif /* DMGL_PROFILE */
+    return result;
+}
+
+int dmgl_inspect(dmgl_instance_t *const instance, dmgl_trace_t *const trace)
+{
+    dmgl_instance_t *current = g_dmgl;
+    if (!instance || !trace)
+    {
+        return DMGL_ERROR("Invalid instance -- %p", instance);
+    }
+    g_dmgl = instance;
+    dmgl_processor_unfuse(&instance->processor); /* A RUN CAN STOP BETWEEN THE HALVES OF A FUSED PAIR */
+    dmgl_capture_trace(trace);
+    g_dmgl = current;
+    return EXIT_SUCCESS;
+}
+
+uint32_t dmgl_observation(const dmgl_instance_t *const instance, uint8_t *const data)
+{
+    if (!instance || !data)
+    {
+        DMGL_ERROR("Invalid instance -- %p", instance);
+        return 0;
+    }
+    return dmgl_video_observation(&instance->video, data);
+}
+
+int dmgl_observe(dmgl_instance_t *const instance, uint8_t width, uint8_t height, uint8_t stack)
+{
+    if (!instance)
+    {
+        return DMGL_ERROR("Invalid instance -- %p", instance);
+    }
+    return dmgl_video_observe(&instance->video, width, height, stack);
+}
+
+int dmgl_profile_dump(const char *const prefix)
+{
+    if (!prefix)
+    {
+        return DMGL_ERROR("Invalid profile prefix -- %p", prefix);
+    }
+#ifdef DMGL_PROFILE
+    return dmgl_processor_profile(prefix);
+#else
+    return DMGL_ERROR("Profiling not built (define DMGL_PROFILE) -- %s", prefix);
+#endif /* DMGL_PROFILE */
+}
+
+int dmgl_reset(dmgl_instance_t *const instance, const dmgl_instance_t *const snapshot)
+{
+    dmgl_save_t *save = NULL;
+    dmgl_audio_buffer_t *buffer = NULL;
+    uint8_t (*color)[160][144] = NULL;
+    dmgl_observe_t observe = {};
+    bool stepped = instance ? instance->processor.stepped : false, traced = instance ? instance->processor.traced : false;
+    uint8_t unfused[32] = {};
+#ifdef DMGL_PROFILE
+    uint32_t countdown = instance ? instance->processor.profile.countdown : 0;
+#endif /* DMGL_PROFILE */
+    if (!instance || !snapshot)
+    {
+        return DMGL_ERROR("Invalid instance -- %p", instance ? snapshot : instance);
+    }
+    if (instance->hash != snapshot->hash)
+    {
+        return DMGL_ERROR("Mismatched snapshot rom hash -- %016lX", (unsigned long)snapshot->hash);
+    }
+    if (instance == snapshot)
+    {
+        return EXIT_SUCCESS;
+    }
+    memcpy(unfused, instance->processor.unfused, sizeof (unfused)); /* BREAKS BELONG TO THE INSTANCE, NOT THE SNAPSHOT */
+    buffer = instance->audio.buffer;
+    color = instance->video.color;
+    observe = instance->video.observe;
+    save = instance->memory.save;
+    instance->audio.buffer = NULL;
+    instance->video.color = NULL;
+    instance->video.observe.data = NULL;
+    dmgl_memory_uninitialize(&instance->memory);
+    dmgl_video_uninitialize(&instance->video);
+    dmgl_instance_fork(instance, snapshot);
+    instance->audio.buffer = buffer; /* KEEP CLIENT OUTPUT BUFFERS, SO A RESET NEVER ALLOCATES */
+    instance->video.color = color;
+    instance->video.observe = observe;
+    instance->video.observe.count = 0; /* THE STACK RESTARTS EMPTY, SINCE ITS FRAMES BELONG TO THE LAST EPISODE */
+    memcpy(instance->processor.unfused, unfused, sizeof (unfused));
+    instance->processor.stepped = stepped;
+    instance->processor.traced = traced;
+#ifdef DMGL_PROFILE
+    instance->processor.profile.countdown = countdown;
+#endif /* DMGL_PROFILE */
+    if ((instance->memory.save = save))
+    { /* THE RESTORED CARTRIDGE RAM REPLACES THE SAVE DATA ON THE NEXT FLUSH */
+        instance->memory.ram.dirty = (1 << instance->memory.ram.count) - 1;
+    }
+    dmgl_rewind_reset(&instance->rewind);
+    return EXIT_SUCCESS;
+}
+
+int dmgl_rewind(uint32_t frames)
+{
+    uint8_t *data = NULL;
+    if (!g_dmgl)
+    {
+        return DMGL_ERROR("Invalid instance -- %p", g_dmgl);
+    }
+    if (g_dmgl->movie.playing || g_dmgl->movie.recording)
+    {
+        return DMGL_ERROR("Rewind unsupported during movie");
+    }
+    if (!(data = dmgl_rewind_pop(&g_dmgl->rewind, (frames < g_dmgl->frame) ? (g_dmgl->frame - frames) : 0)))
+    {
+        return DMGL_ERROR("Rewind unavailable");
+    }
+    if (dmgl_state_load(data, g_dmgl->rewind.length) != EXIT_SUCCESS)
+    { /* THE POPPED STATE STAYS AS THE RING'S NEWEST, SO A LATER REWIND CAN STILL REACH IT */
+        return EXIT_FAILURE;
+    }
+    g_dmgl->frame = g_dmgl->rewind.frame;
+    return EXIT_SUCCESS;
+}
+
+uint32_t dmgl_rewind_frames(void)
+{
+    return g_dmgl ? dmgl_rewind_available(&g_dmgl->rewind, g_dmgl->frame) : 0;
+}
+
+int dmgl_run(dmgl_instance_t *const instance, uint64_t cycles, uint32_t frames, dmgl_stop_t *const stop)
+{
+    uint64_t begin = 0, end = 0, counted = 0, host = dmgl_now();
+    if (!instance || !stop)
+    {
+        return DMGL_ERROR("Invalid instance -- %p", instance);
+    }
+    if (!cycles && !frames && !instance->breakpoint.count)
+    {
+        return DMGL_ERROR("Unbounded run -- %p", instance);
+    }
+    if (instance->movie.playing || instance->movie.recording)
+    { /* MOVIES ADVANCE INPUT ON WHOLE FRAMES, WHICH A RUN MAY STOP PART WAY THROUGH */
+        return DMGL_ERROR("Run during movie -- %p", instance);
+    }
+    g_dmgl = instance;
+    memset(&instance->breakpoint.stop, 0, sizeof (instance->breakpoint.stop));
+    for (uint32_t index = 0; index < instance->breakpoint.count; ++index)
+    {
+        if (instance->breakpoint.entry[index].type == DMGL_BREAK_WRITE)
+        {
+            instance->breakpoint.start[index] = dmgl_peek(instance->breakpoint.entry[index].address);
+        }
+    }
+    instance->breakpoint.hit = false;
+    instance->breakpoint.active = (const uint8_t (*)[0x2000])instance->breakpoint.write;
+    begin = counted = instance->cycle;
+    end = cycles ? (begin + cycles) : UINT64_MAX;
+    for (;;)
+    {
+        const dmgl_processor_t *const processor = &instance->processor;
+        if (instance->cycle == end)
+        {
+            instance->breakpoint.stop.reason = DMGL_STOP_CYCLES;
+            break;
+        }
+        if ((instance->breakpoint.address || instance->breakpoint.opcode) && !processor->delay && !processor->halted && !processor->stopped
+                && (instance->cycle != instance->breakpoint.resume)
+                && ((instance->breakpoint.address && ((*instance->breakpoint.address)[processor->pc.word >> 3] & (1 << (processor->pc.word & 7)))
+                    && dmgl_break_address(processor->pc.word)) || (instance->breakpoint.opcode && dmgl_break_opcode(processor->pc.word))))
+        { /* STOP BEFORE THE INSTRUCTION RUNS, AND LET IT RUN WHEN RESUMED ON THIS CYCLE */
+            instance->breakpoint.stop.reason = DMGL_STOP_BREAK;
+            instance->breakpoint.resume = instance->cycle;
+            break;
+        }
+        if (dmgl_video_clock(&instance->video))
+        { /* FRAME COMPLETE */
+            dmgl_memory_clock(&instance->memory);
+            instance->telemetry.live.cycle += instance->cycle - counted;
+            instance->telemetry.live.host.emulate += dmgl_now() - host;
+            counted = instance->cycle;
+            dmgl_frame();
+            host = dmgl_now();
+            if ((++instance->breakpoint.stop.frames == frames) && frames)
+            {
+                instance->breakpoint.stop.reason = DMGL_STOP_FRAMES;
+                break;
+            }
+            continue;
+        }
+        ++instance->cycle;
+        dmgl_audio_clock(&instance->audio);
+        dmgl_input_clock(&instance->input);
+        dmgl_serial_clock(&instance->serial);
+        dmgl_timer_clock(&instance->timer);
+        dmgl_processor_clock(&instance->processor);
+        if (instance->breakpoint.hit)
+        { /* STOP ONCE THE WRITING INSTRUCTION HAS RUN */
+            instance->breakpoint.stop.reason = DMGL_STOP_BREAK;
+            break;
+        }
+    }
+    instance->breakpoint.active = NULL;
+    instance->breakpoint.stop.cycles = instance->cycle - begin;
+    instance->telemetry.live.cycle += instance->cycle - counted; /* PUBLISHED WITH THE NEXT FRAME */
+    instance->telemetry.live.host.emulate += dmgl_now() - host;
+    *stop = instance->breakpoint.stop;
+    return EXIT_SUCCESS;
+}
+
+void dmgl_select(dmgl_instance_t *const instance)
+{
+    g_dmgl = instance;
+}
+
+uint32_t dmgl_state_length(void)
+{
+    dmgl_state_t state = {};
+    if (!g_dmgl)
+    {
+        return 0;
+    }
+    dmgl_state(&state);
+    return state.offset;
+}
+
+int dmgl_state_load(const uint8_t *const data, uint32_t length)
+{
+    char magic[4] = {};
+    uint32_t expected = dmgl_state_length(), version = 0;
+    dmgl_state_t state = { .data = (uint8_t *)data, .length = length, };
+    if (!g_dmgl)
+    {
+        return DMGL_ERROR("Invalid instance -- %p", g_dmgl);
+    }
+    if (!data || (length != expected))
+    {
+        return DMGL_ERROR("Invalid state length -- %u bytes (expecting %u bytes)", length, expected);
+    }
+    dmgl_state_read(&state, magic, sizeof (magic));
+    if (strncmp(magic, "sta", sizeof (magic)))
+    {
+        return DMGL_ERROR("Invalid state magic");
+    }
+    if ((version = dmgl_state_read_32(&state)) != DMGL_STATE)
+    {
+        return DMGL_ERROR("Unsupported state version -- %u (expecting %u)", version, DMGL_STATE);
+    }
+    if (dmgl_state_read_64(&state) != g_dmgl->hash)
+    {
+        return DMGL_ERROR("Mismatched state rom hash -- %016lX", (unsigned long)g_dmgl->hash);
+    }
+    if (!dmgl_state_check(state))
+    { /* COMPONENTS ARE LOADED IN PLACE, SO EVERYTHING A LOAD CAN REJECT IS CHECKED FIRST */
+        return DMGL_ERROR("Invalid state data");
+    }
+    g_dmgl->cycle = dmgl_state_read_64(&state);
+    dmgl_audio_state_load(&g_dmgl->audio, &state);
+    dmgl_input_state_load(&g_dmgl->input, &state);
+    dmgl_memory_state_load(&g_dmgl->memory, &state);
+    dmgl_processor_state_load(&g_dmgl->processor, &state);
+    dmgl_serial_state_load(&g_dmgl->serial, &state);
+    dmgl_timer_state_load(&g_dmgl->timer, &state);
+    dmgl_video_state_load(&g_dmgl->video, &state);
+    return EXIT_SUCCESS;
+}
+
+int dmgl_state_save(uint8_t *const data, uint32_t length)
+{
+    uint32_t expected = dmgl_state_length();
+    dmgl_state_t state = { .data = data, .length = length, };
+    if (!g_dmgl)
+    {
+        return DMGL_ERROR("Invalid instance -- %p", g_dmgl);
+    }
+    if (!data || (length < expected))
+    {
+        return DMGL_ERROR("Invalid state length -- %u bytes (expecting >= %u bytes)", length, expected);
+    }
+    dmgl_state(&state);
+    return EXIT_SUCCESS;
+}
+
+int dmgl_step(dmgl_instance_t *const instance, uint32_t frames)
+{
+    int result = EXIT_SUCCESS;
+    if (!(g_dmgl = instance))
+    {
+        return DMGL_ERROR("Invalid instance -- %p", instance);
+    }
+    for (uint32_t frame = 0; frame < frames; ++frame)
+    {
+        if ((result = dmgl_poll()) != EXIT_SUCCESS)
+        {
+            break;
+        }
+        dmgl_clock();
+        if ((result = dmgl_sync()) != EXIT_SUCCESS)
+        {
+            break;
+        }
+        dmgl_frame();
+    }
+    return result;
+}
+
+int dmgl_telemetry(const dmgl_instance_t *const instance, dmgl_telemetry_t *const telemetry)
+{
+    uint32_t sequence = 0;
+    const dmgl_instance_t *source = instance ? instance : g_dmgl;
+    uint64_t *destination = (uint64_t *)telemetry;
+    if (!source || !telemetry)
+    {
+        return DMGL_ERROR("Invalid instance -- %p", source);
+    }
+    do
+    { /* THE INSTANCE NEVER WAITS ON A READER, SO THIS IS SAFE FROM ANY THREAD WHILE IT RUNS */
+        while ((sequence = __atomic_load_n(&source->telemetry.sequence, __ATOMIC_ACQUIRE)) & 1);
+        for (uint32_t index = 0; index < (sizeof (dmgl_telemetry_t) / sizeof (uint64_t)); ++index)
+        {
+            destination[index] = __atomic_load_n(&((const uint64_t *)&source->telemetry.published)[index], __ATOMIC_RELAXED);
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    }
+    while (__atomic_load_n(&source->telemetry.sequence, __ATOMIC_RELAXED) != sequence);
+    return EXIT_SUCCESS;
+}
+
+const uint8_t *dmgl_view(dmgl_instance_t *const instance, uint16_t address, uint16_t length)
+{
+    if (!instance)
+    {
+        DMGL_ERROR("Invalid instance -- %p", instance);
+        return NULL;
+    }
+    return dmgl_memory_view(&instance->memory, address, length);
+}
+
+uint16_t dmgl_bank(uint16_t address)
+{
+    return dmgl_memory_bank(&g_dmgl->memory, address);
+}
+
 uint8_t dmgl_input(uint8_t value)
 {
-    return dmgl_serial_input(&g_dmgl.serial, value);
+    return dmgl_serial_input(&g_dmgl->serial, value);
 }
 
 void dmgl_interrupt(uint8_t interrupt)
@@ -133,10 +1228,10 @@ void dmgl_interrupt(uint8_t interrupt)
     switch (interrupt)
     {
         case 0 ... 4: /* PROCESSOR */
-            dmgl_processor_interrupt(&g_dmgl.processor, interrupt);
+            dmgl_processor_interrupt(&g_dmgl->processor, interrupt);
             break;
         case 5: /* AUDIO */
-            dmgl_audio_interrupt(&g_dmgl.audio);
+            dmgl_audio_interrupt(&g_dmgl->audio);
             break;
         default:
             break;
@@ -145,75 +1240,160 @@ void dmgl_interrupt(uint8_t interrupt)
 
 uint8_t dmgl_output(uint8_t value)
 {
-    return g_dmgl.context->client.output(value);
+    return g_dmgl->context->client.output ? g_dmgl->context->client.output(value) : 1;
 }
 
-uint8_t dmgl_read(uint16_t address)
+uint8_t dmgl_peek(uint16_t address)
 {
     uint8_t result = 0xFF;
     switch (address)
     {
         case 0xFF00: /* INPUT */
-            result = dmgl_input_read(&g_dmgl.input, address);
+            result = dmgl_input_read(&g_dmgl->input, address);
             break;
         case 0xFF01 ... 0xFF02: /* SERIAL */
-            result = dmgl_serial_read(&g_dmgl.serial, address);
+            result = dmgl_serial_read(&g_dmgl->serial, address);
             break;
         case 0xFF04 ... 0xFF07: /* TIMER */
-            result = dmgl_timer_read(&g_dmgl.timer, address);
+            result = dmgl_timer_read(&g_dmgl->timer, address);
             break;
         case 0xFF10 ... 0xFF14: /* AUDIO */
         case 0xFF16 ... 0xFF1E:
         case 0xFF20 ... 0xFF26:
         case 0xFF30 ... 0xFF3F:
-            result = dmgl_audio_read(&g_dmgl.audio, address);
+            result = dmgl_audio_read(&g_dmgl->audio, address);
             break;
         case 0x8000 ... 0x9FFF: /* VIDEO */
         case 0xFE00 ... 0xFE9F:
         case 0xFF40 ... 0xFF4B:
-            result = dmgl_video_read(&g_dmgl.video, address);
+            result = dmgl_video_read(&g_dmgl->video, address);
             break;
         case 0xFF0F: /* PROCESSOR */
         case 0xFFFF:
-            result = dmgl_processor_read(&g_dmgl.processor, address);
+            result = dmgl_processor_read(&g_dmgl->processor, address);
             break;
         default: /* MEMORY */
-            result = dmgl_memory_read(&g_dmgl.memory, address);
+            result = dmgl_memory_read(&g_dmgl->memory, address);
             break;
     }
     return result;
 }
 
+uint8_t dmgl_read(uint16_t address)
+{
+    ++g_dmgl->telemetry.live.read[dmgl_region(address)];
+    if (dmgl_bootrom(address))
+    { /* THE BOOTROM IS NOT PART OF THE CARTRIDGE, SO IT IS NEVER COUNTED AS BANK 0 */
+        return dmgl_peek(address);
+    }
+    if (g_dmgl->heatmap)
+    {
+        dmgl_heatmap_access(g_dmgl->heatmap, DMGL_HEATMAP_READ, dmgl_memory_bank(&g_dmgl->memory, address), address);
+    }
+    if (g_dmgl->coverage && (address < 0x8000) && (address != (uint16_t)(g_dmgl->processor.pc.word - 1)))
+    { /* FETCHES READ AT PC AND STEP PAST IT FIRST, SO ANYTHING ELSE IS DATA */
+        dmgl_coverage_mark(g_dmgl->coverage, DMGL_COVERAGE_DATA, dmgl_memory_bank(&g_dmgl->memory, address), address);
+    }
+    return dmgl_peek(address);
+}
+
+#ifdef DMGL_PROFILE
+uint32_t dmgl_sample(void)
+{
+    uint32_t frame[64] = {};
+    const dmgl_processor_t *const processor = &g_dmgl->processor;
+    for (uint8_t index = 0; index < processor->profile.depth; ++index)
+    {
+        frame[index] = (processor->profile.frame[index].bank << 16) | processor->profile.frame[index].address;
+    }
+    dmgl_sampler_add(g_dmgl->sampler, frame, processor->profile.depth, /* THE SAMPLED STEP HAS RUN, SO CHARGE THE NEXT INSTRUCTION WITH THE STACK IT LEFT */
+        (dmgl_bank(processor->pc.word) << 16) | processor->pc.word, g_dmgl->context->profile.interval);
+    return g_dmgl->context->profile.interval;
+}
+#endif /* DMGL_PROFILE */
+
+void dmgl_trace(void)
+{
+    dmgl_trace_t trace = {};
+    if (g_dmgl->heatmap && !dmgl_bootrom(g_dmgl->processor.pc.word))
+    {
+        dmgl_heatmap_access(g_dmgl->heatmap, DMGL_HEATMAP_EXECUTE, dmgl_memory_bank(&g_dmgl->memory, g_dmgl->processor.pc.word),
+            g_dmgl->processor.pc.word);
+    }
+    if (g_dmgl->coverage && (g_dmgl->processor.pc.word < 0x8000) && !dmgl_bootrom(g_dmgl->processor.pc.word))
+    {
+        dmgl_coverage_mark(g_dmgl->coverage, DMGL_COVERAGE_CODE, dmgl_memory_bank(&g_dmgl->memory, g_dmgl->processor.pc.word),
+            g_dmgl->processor.pc.word);
+    }
+    if (g_dmgl->tracer)
+    {
+        dmgl_capture_trace(&trace);
+        dmgl_tracer_push(g_dmgl->tracer, &trace);
+    }
+}
+
 void dmgl_write(uint16_t address, uint8_t value)
 {
+    uint16_t bank[3] = {};
+    const uint16_t window[3] = { 0x0000, 0x4000, 0xA000, };
+    ++g_dmgl->telemetry.live.write[dmgl_region(address)];
+    if (g_dmgl->heatmap)
+    {
+        if (address < 0x8000)
+        { /* MAPPER REGISTERS, SO NOTE THE BANKS IN EACH WINDOW BEFORE THE WRITE LANDS */
+            dmgl_heatmap_mapper(g_dmgl->heatmap, address);
+            for (uint8_t index = 0; index < 3; ++index)
+            {
+                bank[index] = dmgl_memory_bank(&g_dmgl->memory, window[index]);
+            }
+        }
+        else
+        {
+            dmgl_heatmap_access(g_dmgl->heatmap, DMGL_HEATMAP_WRITE, dmgl_memory_bank(&g_dmgl->memory, address), address);
+        }
+    }
     switch (address)
     {
         case 0xFF00: /* INPUT */
-            dmgl_input_write(&g_dmgl.input, address, value);
+            dmgl_input_write(&g_dmgl->input, address, value);
             break;
         case 0xFF01 ... 0xFF02: /* SERIAL */
-            dmgl_serial_write(&g_dmgl.serial, address, value);
+            dmgl_serial_write(&g_dmgl->serial, address, value);
             break;
         case 0xFF04 ... 0xFF07: /* TIMER */
-            dmgl_timer_write(&g_dmgl.timer, address, value);
+            dmgl_timer_write(&g_dmgl->timer, address, value);
             break;
         case 0xFF10 ... 0xFF14: /* AUDIO */
         case 0xFF16 ... 0xFF1E:
         case 0xFF20 ... 0xFF26:
         case 0xFF30 ... 0xFF3F:
-            dmgl_audio_write(&g_dmgl.audio, address, value);
+            dmgl_audio_write(&g_dmgl->audio, address, value);
             break;
         case 0x8000 ... 0x9FFF: /* VIDEO */
         case 0xFE00 ... 0xFE9F:
         case 0xFF40 ... 0xFF4B:
-            dmgl_video_write(&g_dmgl.video, address, value);
+            dmgl_video_write(&g_dmgl->video, address, value);
             break;
         case 0xFF0F: /* PROCESSOR */
         case 0xFFFF:
-            dmgl_processor_write(&g_dmgl.processor, address, value);
+            dmgl_processor_write(&g_dmgl->processor, address, value);
             break;
         default: /* MEMORY */
-            dmgl_memory_write(&g_dmgl.memory, address, value);
+            dmgl_memory_write(&g_dmgl->memory, address, value);
             break;
     }
+    if (g_dmgl->heatmap && (address < 0x8000))
+    {
+        for (uint8_t index = 0; index < 3; ++index)
+        {
+            if (dmgl_memory_bank(&g_dmgl->memory, window[index]) != bank[index])
+            {
+                dmgl_heatmap_select(g_dmgl->heatmap, window[index], dmgl_memory_bank(&g_dmgl->memory, window[index]));
+            }
+        }
+    }
+    if (g_dmgl->breakpoint.active && ((*g_dmgl->breakpoint.active)[address >> 3] & (1 << (address & 7))))
+    { /* ONLY SET WHILE RUNNING UNTIL A BREAK */
+        dmgl_break_write(address, value);
+    }
 }
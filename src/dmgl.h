@@ -9,11 +9,48 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#define DMGL_BANK_ANY 0xFFFF
+
+#define DMGL_BREAK_ADDRESS 0 /* EXECUTION REACHES AN ADDRESS */
+#define DMGL_BREAK_WRITE 1 /* A WRITE TO AN ADDRESS PASSES A COMPARE */
+#define DMGL_BREAK_OPCODE 2 /* EXECUTION REACHES AN OPCODE THAT PASSES A COMPARE */
+
+#define DMGL_COMPARE_ANY 0
+#define DMGL_COMPARE_EQUAL 1
+#define DMGL_COMPARE_NOT_EQUAL 2
+#define DMGL_COMPARE_LESS 3
+#define DMGL_COMPARE_GREATER 4
+#define DMGL_COMPARE_CHANGED 5 /* AGAINST THE VALUE WHEN THE RUN STARTED */
+
+#define DMGL_COVERAGE_CODE 1 /* EXECUTED AS AN OPCODE */
+#define DMGL_COVERAGE_DATA 2 /* READ AS DATA, OUTSIDE THE INSTRUCTION STREAM */
+
+#define DMGL_REGION_ROM 0
+#define DMGL_REGION_VIDEO 1 /* VRAM */
+#define DMGL_REGION_CARTRIDGE 2 /* CARTRIDGE RAM */
+#define DMGL_REGION_WORK 3 /* WRAM, AND ITS MIRROR */
+#define DMGL_REGION_OBJECT 4 /* OAM, AND THE UNUSED SPACE AFTER IT */
+#define DMGL_REGION_IO 5 /* REGISTERS, AND IE */
+#define DMGL_REGION_HIGH 6 /* HRAM */
+#define DMGL_REGION_COUNT 7
+
+#define DMGL_STOP_BREAK 0
+#define DMGL_STOP_CYCLES 1
+#define DMGL_STOP_FRAMES 2
+
 typedef struct
 {
     uint8_t palette;
     uint8_t scale;
     struct
+    {
+        bool skip;
+    } bootrom;
+    struct
+    {
+        const char *path;
+    } cache;
+    struct
     {
         int (*initialize)(const char *const title, uint8_t scale);
         uint8_t (*input)(uint8_t value);
@@ -23,17 +60,159 @@ typedef struct
         void (*uninitialize)(void);
     } client;
     struct
+    {
+        const char *path;
+    } coverage;
+    struct
+    {
+        const char *path;
+    } heatmap;
+    struct
     {
         uint8_t *data;
         uint32_t length;
+        bool cycle;
+        bool record;
+    } movie;
+    struct
+    {
+        const char *path;
+        const char *symbols;
+        uint32_t interval;
+    } profile;
+    struct
+    {
+        uint8_t *data;
+        uint32_t length;
+        uint32_t interval;
     } ram;
     struct
+    {
+        uint32_t interval;
+        uint32_t length;
+    } rewind;
+    struct
     {
         uint8_t *data;
         uint32_t length;
     } rom;
+    struct
+    {
+        const char *path;
+    } trace;
 } dmgl_t;
 
+typedef struct
+{
+    uint16_t address;
+    uint16_t length;
+} dmgl_range_t;
+
+typedef struct
+{
+    uint32_t frames;
+    uint32_t threads;
+    struct
+    {
+        uint8_t *data;
+        uint8_t width;
+        uint8_t height;
+        uint8_t stack;
+    } frame;
+    struct
+    {
+        uint8_t *data;
+        const dmgl_range_t *range;
+        uint32_t count;
+    } ram;
+    struct
+    {
+        float *data;
+        float (*callback)(const uint8_t *const ram, uint32_t length, void *argument);
+        void *argument;
+    } reward;
+} dmgl_batch_t;
+
+typedef struct
+{
+    uint8_t type;
+    uint16_t address;
+    uint16_t bank;
+    struct
+    {
+        uint8_t type;
+        uint8_t mask;
+        uint8_t value;
+    } compare;
+} dmgl_break_t;
+
+typedef struct
+{
+    uint64_t cycle;
+    uint64_t color;
+    uint64_t vram;
+    uint64_t wram;
+} dmgl_digest_t;
+
+typedef struct dmgl_instance_s dmgl_instance_t;
+
+typedef struct dmgl_pool_s dmgl_pool_t;
+
+typedef struct dmgl_watch_s dmgl_watch_t;
+
+typedef struct
+{
+    uint8_t reason;
+    uint32_t index;
+    uint16_t address;
+    uint8_t value;
+    uint64_t cycles;
+    uint32_t frames;
+} dmgl_stop_t;
+
+typedef struct
+{
+    uint64_t frame;
+    uint64_t cycle;
+    uint64_t halted; /* CYCLES SPENT IN HALT OR STOP */
+    uint64_t instruction;
+    uint64_t read[DMGL_REGION_COUNT];
+    uint64_t write[DMGL_REGION_COUNT];
+    uint64_t interrupt[5]; /* VBLANK, STATUS, TIMER, SERIAL, INPUT */
+    uint64_t transfer; /* OAM DMA */
+    uint64_t bank;
+    uint64_t sample;
+    struct
+    {
+        uint64_t emulate;
+        uint64_t poll;
+        uint64_t sync;
+        uint64_t capture;
+        uint64_t flush;
+    } host; /* NANOSECONDS */
+} dmgl_telemetry_t;
+
+typedef struct
+{
+    uint64_t cycle;
+    uint16_t bank;
+    uint16_t pc;
+    uint16_t af;
+    uint16_t bc;
+    uint16_t de;
+    uint16_t hl;
+    uint16_t sp;
+    uint8_t opcode[3]; /* THE BYTES AT PC, WHATEVER THE INSTRUCTION LENGTH */
+    struct
+    {
+        uint8_t enabled;
+        uint8_t enable;
+        uint8_t flag;
+    } interrupt;
+} dmgl_trace_t;
+
+typedef struct dmgl_trace_reader_s dmgl_trace_reader_t;
+
 typedef struct
 {
     uint32_t major;
@@ -42,7 +221,51 @@ typedef struct
 } dmgl_version_t;
 
 int dmgl(dmgl_t *const context);
+int dmgl_batch(dmgl_instance_t *const *const instance, const uint8_t *const action, uint32_t count, const dmgl_batch_t *const batch);
+int dmgl_break_add(dmgl_instance_t *const instance, const dmgl_break_t *const condition);
+void dmgl_break_clear(dmgl_instance_t *const instance);
+int dmgl_cache_save(void);
+uint8_t dmgl_coverage(const dmgl_instance_t *const instance, uint16_t bank, uint16_t address);
+dmgl_instance_t *dmgl_create(dmgl_t *const context);
+void dmgl_destroy(dmgl_instance_t *const instance);
+int dmgl_digest(dmgl_instance_t *const instance, dmgl_digest_t *const digest);
+uint8_t dmgl_disassemble(char *const text, uint32_t length, uint16_t address, const uint8_t *const data);
 const char *dmgl_error(void);
+dmgl_instance_t *dmgl_fork(const dmgl_instance_t *const instance);
+uint32_t dmgl_gather(dmgl_instance_t *const instance, const dmgl_range_t *const range, uint32_t count, uint8_t *const data);
+int dmgl_inspect(dmgl_instance_t *const instance, dmgl_trace_t *const trace);
+uint32_t dmgl_observation(const dmgl_instance_t *const instance, uint8_t *const data);
+int dmgl_observe(dmgl_instance_t *const instance, uint8_t width, uint8_t height, uint8_t stack);
+int dmgl_pool_capture(dmgl_pool_t *const pool, const dmgl_instance_t *const instance);
+dmgl_pool_t *dmgl_pool_create(void);
+void dmgl_pool_destroy(dmgl_pool_t *const pool);
+uint32_t dmgl_pool_length(dmgl_pool_t *const pool);
+int dmgl_pool_reset(dmgl_pool_t *const pool, dmgl_instance_t *const instance, uint64_t seed);
+int dmgl_profile_dump(const char *const prefix);
+int dmgl_reset(dmgl_instance_t *const instance, const dmgl_instance_t *const snapshot);
+int dmgl_rewind(uint32_t frames);
+uint32_t dmgl_rewind_frames(void);
+int dmgl_rom_map(const char *const path, uint8_t **data, uint32_t *length);
+int dmgl_rom_unmap(const uint8_t *const data);
+int dmgl_run(dmgl_instance_t *const instance, uint64_t cycles, uint32_t frames, dmgl_stop_t *const stop);
+int dmgl_save_map(const char *const path, uint8_t **data, uint32_t *length);
+int dmgl_save_unmap(const uint8_t *const data);
+void dmgl_select(dmgl_instance_t *const instance);
+uint32_t dmgl_state_length(void);
+int dmgl_state_load(const uint8_t *const data, uint32_t length);
+int dmgl_state_save(uint8_t *const data, uint32_t length);
+int dmgl_step(dmgl_instance_t *const instance, uint32_t frames);
+int dmgl_telemetry(const dmgl_instance_t *const instance, dmgl_telemetry_t *const telemetry);
+int dmgl_trace_close(dmgl_trace_reader_t *const reader);
+uint32_t dmgl_trace_next(dmgl_trace_reader_t *const reader, dmgl_trace_t *const trace);
+dmgl_trace_reader_t *dmgl_trace_open(const char *const path);
 const dmgl_version_t *dmgl_version(void);
+const uint8_t *dmgl_view(dmgl_instance_t *const instance, uint16_t address, uint16_t length);
+int dmgl_watch_add(dmgl_watch_t *const watch, const char *const name, uint16_t address, uint16_t length);
+dmgl_watch_t *dmgl_watch_create(void);
+void dmgl_watch_destroy(dmgl_watch_t *const watch);
+uint32_t dmgl_watch_gather(const dmgl_watch_t *const watch, dmgl_instance_t *const instance, uint8_t *const data);
+uint32_t dmgl_watch_length(const dmgl_watch_t *const watch);
+uint32_t dmgl_watch_offset(const dmgl_watch_t *const watch, const char *const name);
 
 #endif /* DMGL_H_ */
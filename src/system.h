@@ -8,10 +8,16 @@
 
 #include <common.h>
 
+uint16_t dmgl_bank(uint16_t address);
 uint8_t dmgl_input(uint8_t value);
 void dmgl_interrupt(uint8_t interrupt);
 uint8_t dmgl_output(uint8_t value);
+uint8_t dmgl_peek(uint16_t address);
 uint8_t dmgl_read(uint16_t address);
+#ifdef DMGL_PROFILE
+uint32_t dmgl_sample(void);
+#endif /* DMGL_PROFILE */
+void dmgl_trace(void);
 void dmgl_write(uint16_t address, uint8_t value);
 
 #endif /* DMGL_SYSTEM_H_ */
@@ -5,6 +5,8 @@
 
 #include <audio.h>
 
+static const float SILENCE[735] = {};
+
 static float dmgl_audio_channel_1(dmgl_audio_t *const audio)
 {
     float result = audio->channel_1.sample;
@@ -23,40 +25,40 @@ static float dmgl_audio_channel_1(dmgl_audio_t *const audio)
 static uint16_t dmgl_audio_count(dmgl_audio_t *const audio)
 {
     uint16_t result = 0;
-    if (audio->buffer.read < audio->buffer.write)
+    if (audio->buffer->read < audio->buffer->write)
     {
-        result = audio->buffer.write - audio->buffer.read;
+        result = audio->buffer->write - audio->buffer->read;
     }
-    else if (audio->buffer.read > audio->buffer.write)
+    else if (audio->buffer->read > audio->buffer->write)
     {
-        result = (sizeof (audio->buffer.data) / sizeof (*audio->buffer.data)) - audio->buffer.read;
-        if (audio->buffer.write)
+        result = (sizeof (audio->buffer->data) / sizeof (*audio->buffer->data)) - audio->buffer->read;
+        if (audio->buffer->write)
         {
-            result += audio->buffer.write;
+            result += audio->buffer->write;
         }
     }
-    else if (!audio->buffer.full)
+    else if (!audio->buffer->full)
     {
-        result = sizeof (audio->buffer.data) / sizeof (*audio->buffer.data);
+        result = sizeof (audio->buffer->data) / sizeof (*audio->buffer->data);
     }
     return result;
 }
 
 static float dmgl_audio_dequeue(dmgl_audio_t *const audio)
 {
-    float result = audio->buffer.data[audio->buffer.read++];
-    audio->buffer.read %= sizeof (audio->buffer.data) / sizeof (*audio->buffer.data);
-    audio->buffer.full = false;
+    float result = audio->buffer->data[audio->buffer->read++];
+    audio->buffer->read %= sizeof (audio->buffer->data) / sizeof (*audio->buffer->data);
+    audio->buffer->full = false;
     return result;
 }
 
 static void dmgl_audio_enqueue(dmgl_audio_t *const audio, float sample)
 {
-    if (!audio->buffer.full)
+    if (audio->buffer && !audio->buffer->full)
     {
-        audio->buffer.data[audio->buffer.write++] = sample;
-        audio->buffer.write %= sizeof (audio->buffer.data) / sizeof (*audio->buffer.data);
-        audio->buffer.full = (audio->buffer.write == audio->buffer.read);
+        audio->buffer->data[audio->buffer->write++] = sample;
+        audio->buffer->write %= sizeof (audio->buffer->data) / sizeof (*audio->buffer->data);
+        audio->buffer->full = (audio->buffer->write == audio->buffer->read);
     }
 }
 
@@ -74,12 +76,19 @@ void dmgl_audio_clock(dmgl_audio_t *const audio)
             /* TODO: SAMPLE CHANNEL 2-4 */
             sample = ((channel[0] + channel[1] + channel[2] + channel[3]) / 4.f) * ((audio->volume.right + audio->volume.left) / 14.f);
             dmgl_audio_enqueue(audio, sample);
+            ++audio->telemetry->sample;
         }
         audio->delay.clock = 95; /* 44.1 KHz */
     }
     --audio->delay.clock;
 }
 
+void dmgl_audio_fork(dmgl_audio_t *const audio, const dmgl_audio_t *const parent)
+{
+    memcpy(audio, parent, sizeof (*audio));
+    audio->buffer = NULL;
+}
+
 void dmgl_audio_interrupt(dmgl_audio_t *const audio)
 {
     if (audio->control.channel_1_enabled)
@@ -165,18 +174,99 @@ uint8_t dmgl_audio_read(const dmgl_audio_t *const audio, uint16_t address)
 
 const float (*dmgl_audio_sample(dmgl_audio_t *const audio))[735]
 {
-    if (dmgl_audio_count(audio) >= sizeof (audio->buffer.sample) / sizeof (*audio->buffer.sample))
+    if (!audio->buffer && !(audio->buffer = calloc(1, sizeof (*audio->buffer))))
+    { /* SAMPLES ARE ONLY QUEUED ONCE A CLIENT ASKS FOR THEM */
+        DMGL_ERROR("Failed to allocate audio buffer -- %zu bytes", sizeof (*audio->buffer));
+        return &SILENCE;
+    }
+    if (dmgl_audio_count(audio) >= sizeof (audio->buffer->sample) / sizeof (*audio->buffer->sample))
     {
-        for (uint16_t index = 0; index < sizeof (audio->buffer.sample) / sizeof (*audio->buffer.sample); ++index)
+        for (uint16_t index = 0; index < sizeof (audio->buffer->sample) / sizeof (*audio->buffer->sample); ++index)
         {
-            audio->buffer.sample[index] = dmgl_audio_dequeue(audio);
+            audio->buffer->sample[index] = dmgl_audio_dequeue(audio);
         }
     }
     else
     {
-        memset(audio->buffer.sample, 0, sizeof (audio->buffer.sample));
+        memset(audio->buffer->sample, 0, sizeof (audio->buffer->sample));
+    }
+    return &audio->buffer->sample;
+}
+
+void dmgl_audio_state_load(dmgl_audio_t *const audio, dmgl_state_t *const state)
+{
+    if (audio->buffer)
+    { /* QUEUED SAMPLES ARE CLIENT OUTPUT, NOT MACHINE STATE */
+        audio->buffer->full = false;
+        audio->buffer->read = 0;
+        audio->buffer->write = 0;
     }
-    return &audio->buffer.sample;
+    audio->channel_1.sample = dmgl_state_read_float(state);
+    audio->channel_1.envelope.raw = dmgl_state_read_8(state);
+    audio->channel_1.frequency.low = dmgl_state_read_8(state);
+    audio->channel_1.frequency.high = dmgl_state_read_8(state);
+    audio->channel_1.length.raw = dmgl_state_read_8(state);
+    audio->channel_1.sweep.raw = dmgl_state_read_8(state);
+    audio->channel_2.sample = dmgl_state_read_float(state);
+    audio->channel_2.envelope.raw = dmgl_state_read_8(state);
+    audio->channel_2.frequency.low = dmgl_state_read_8(state);
+    audio->channel_2.frequency.high = dmgl_state_read_8(state);
+    audio->channel_2.length.raw = dmgl_state_read_8(state);
+    audio->channel_3.sample = dmgl_state_read_float(state);
+    audio->channel_3.length = dmgl_state_read_8(state);
+    dmgl_state_read(state, audio->channel_3.ram, sizeof (audio->channel_3.ram));
+    audio->channel_3.frequency.low = dmgl_state_read_8(state);
+    audio->channel_3.frequency.high = dmgl_state_read_8(state);
+    audio->channel_3.control.raw = dmgl_state_read_8(state);
+    audio->channel_3.level.raw = dmgl_state_read_8(state);
+    audio->channel_4.sample = dmgl_state_read_float(state);
+    audio->channel_4.envelope.raw = dmgl_state_read_8(state);
+    audio->channel_4.length.raw = dmgl_state_read_8(state);
+    audio->channel_4.control.raw = dmgl_state_read_8(state);
+    audio->channel_4.frequency.raw = dmgl_state_read_8(state);
+    audio->control.raw = dmgl_state_read_8(state);
+    audio->delay.clock = dmgl_state_read_16(state);
+    audio->delay.interrupt = dmgl_state_read_8(state);
+    audio->mixer.raw = dmgl_state_read_8(state);
+    audio->volume.raw = dmgl_state_read_8(state);
+}
+
+void dmgl_audio_state_save(const dmgl_audio_t *const audio, dmgl_state_t *const state)
+{
+    dmgl_state_write_float(state, audio->channel_1.sample);
+    dmgl_state_write_8(state, audio->channel_1.envelope.raw);
+    dmgl_state_write_8(state, audio->channel_1.frequency.low);
+    dmgl_state_write_8(state, audio->channel_1.frequency.high);
+    dmgl_state_write_8(state, audio->channel_1.length.raw);
+    dmgl_state_write_8(state, audio->channel_1.sweep.raw);
+    dmgl_state_write_float(state, audio->channel_2.sample);
+    dmgl_state_write_8(state, audio->channel_2.envelope.raw);
+    dmgl_state_write_8(state, audio->channel_2.frequency.low);
+    dmgl_state_write_8(state, audio->channel_2.frequency.high);
+    dmgl_state_write_8(state, audio->channel_2.length.raw);
+    dmgl_state_write_float(state, audio->channel_3.sample);
+    dmgl_state_write_8(state, audio->channel_3.length);
+    dmgl_state_write(state, audio->channel_3.ram, sizeof (audio->channel_3.ram));
+    dmgl_state_write_8(state, audio->channel_3.frequency.low);
+    dmgl_state_write_8(state, audio->channel_3.frequency.high);
+    dmgl_state_write_8(state, audio->channel_3.control.raw);
+    dmgl_state_write_8(state, audio->channel_3.level.raw);
+    dmgl_state_write_float(state, audio->channel_4.sample);
+    dmgl_state_write_8(state, audio->channel_4.envelope.raw);
+    dmgl_state_write_8(state, audio->channel_4.length.raw);
+    dmgl_state_write_8(state, audio->channel_4.control.raw);
+    dmgl_state_write_8(state, audio->channel_4.frequency.raw);
+    dmgl_state_write_8(state, audio->control.raw);
+    dmgl_state_write_16(state, audio->delay.clock);
+    dmgl_state_write_8(state, audio->delay.interrupt);
+    dmgl_state_write_8(state, audio->mixer.raw);
+    dmgl_state_write_8(state, audio->volume.raw);
+}
+
+void dmgl_audio_uninitialize(dmgl_audio_t *const audio)
+{
+    free(audio->buffer);
+    audio->buffer = NULL;
 }
 
 void dmgl_audio_write(dmgl_audio_t *const audio, uint16_t address, uint8_t value)
@@ -323,7 +413,10 @@ void dmgl_audio_write(dmgl_audio_t *const audio, uint16_t address, uint8_t value
             audio->control.raw = value & 0x80;
             if (!audio->control.enabled)
             {
-                memset(&audio->buffer, 0, sizeof (audio->buffer));
+                if (audio->buffer)
+                {
+                    memset(audio->buffer, 0, sizeof (*audio->buffer));
+                }
                 memset(&audio->channel_1, 0, sizeof (audio->channel_1));
                 memset(&audio->channel_2, 0, sizeof (audio->channel_2));
                 memset(&audio->channel_3, 0, sizeof (audio->channel_3));
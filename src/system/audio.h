@@ -63,14 +63,17 @@ typedef union
 
 typedef struct
 {
-    struct
-    {
-        bool full;
-        uint16_t read;
-        uint16_t write;
-        float data[44100];
-        float sample[735];
-    } buffer;
+    bool full;
+    uint16_t read;
+    uint16_t write;
+    float data[44100];
+    float sample[735];
+} dmgl_audio_buffer_t;
+
+typedef struct
+{
+    dmgl_audio_buffer_t *buffer;
+    dmgl_telemetry_t *telemetry;
     struct
     {
         float sample;
@@ -185,9 +188,13 @@ typedef struct
 } dmgl_audio_t;
 
 void dmgl_audio_clock(dmgl_audio_t *const audio);
+void dmgl_audio_fork(dmgl_audio_t *const audio, const dmgl_audio_t *const parent);
 void dmgl_audio_interrupt(dmgl_audio_t *const audio);
 uint8_t dmgl_audio_read(const dmgl_audio_t *const audio, uint16_t address);
 const float (*dmgl_audio_sample(dmgl_audio_t *const audio))[735];
+void dmgl_audio_state_load(dmgl_audio_t *const audio, dmgl_state_t *const state);
+void dmgl_audio_state_save(const dmgl_audio_t *const audio, dmgl_state_t *const state);
+void dmgl_audio_uninitialize(dmgl_audio_t *const audio);
 void dmgl_audio_write(dmgl_audio_t *const audio, uint16_t address, uint8_t value);
 
 #endif /* DMGL_AUDIO_H_ */
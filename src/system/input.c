@@ -46,6 +46,28 @@ bool (*dmgl_input_state(dmgl_input_t *const input))[8]
     return &input->state[0];
 }
 
+void dmgl_input_state_load(dmgl_input_t *const input, dmgl_state_t *const state)
+{
+    input->delay = dmgl_state_read_16(state);
+    for (uint8_t button = 0; button < 8; ++button)
+    {
+        input->state[0][button] = dmgl_state_read_8(state);
+        input->state[1][button] = dmgl_state_read_8(state);
+    }
+    input->control.raw = dmgl_state_read_8(state);
+}
+
+void dmgl_input_state_save(const dmgl_input_t *const input, dmgl_state_t *const state)
+{
+    dmgl_state_write_16(state, input->delay);
+    for (uint8_t button = 0; button < 8; ++button)
+    {
+        dmgl_state_write_8(state, input->state[0][button]);
+        dmgl_state_write_8(state, input->state[1][button]);
+    }
+    dmgl_state_write_8(state, input->control.raw);
+}
+
 void dmgl_input_write(dmgl_input_t *const input, uint16_t address, uint8_t value)
 {
     switch (address)
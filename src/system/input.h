@@ -27,6 +27,8 @@ typedef struct
 void dmgl_input_clock(dmgl_input_t *const input);
 uint8_t dmgl_input_read(const dmgl_input_t *const input, uint16_t address);
 bool (*dmgl_input_state(dmgl_input_t *const input))[8];
+void dmgl_input_state_load(dmgl_input_t *const input, dmgl_state_t *const state);
+void dmgl_input_state_save(const dmgl_input_t *const input, dmgl_state_t *const state);
 void dmgl_input_write(dmgl_input_t *const input, uint16_t address, uint8_t value);
 
 #endif /*  DMGL_INPUT_H_ */
@@ -40,6 +40,24 @@ static const dmgl_cartridge_t *dmgl_memory_cartridge(const uint8_t *const data)
     return (const dmgl_cartridge_t *)&data[0x0100];
 }
 
+static void dmgl_memory_clock_load(dmgl_clock_t *const clock, dmgl_state_t *const state)
+{
+    clock->second.raw = dmgl_state_read_8(state);
+    clock->minute.raw = dmgl_state_read_8(state);
+    clock->hour.raw = dmgl_state_read_8(state);
+    clock->day.low = dmgl_state_read_8(state);
+    clock->day.high = dmgl_state_read_8(state);
+}
+
+static void dmgl_memory_clock_save(const dmgl_clock_t *const clock, dmgl_state_t *const state)
+{
+    dmgl_state_write_8(state, clock->second.raw);
+    dmgl_state_write_8(state, clock->minute.raw);
+    dmgl_state_write_8(state, clock->hour.raw);
+    dmgl_state_write_8(state, clock->day.low);
+    dmgl_state_write_8(state, clock->day.high);
+}
+
 static uint8_t dmgl_memory_checksum(const uint8_t *const data, uint16_t begin, uint16_t end)
 {
     uint8_t result = 0;
@@ -50,6 +68,22 @@ static uint8_t dmgl_memory_checksum(const uint8_t *const data, uint16_t begin, u
     return result;
 }
 
+static void dmgl_memory_mapper_ram_enable(dmgl_memory_t *const memory, uint8_t value)
+{
+    bool enabled = ((value & 0x0F) == 0x0A);
+    if (memory->mapper.ram.enabled && !enabled)
+    { /* GAMES DISABLE RAM ONCE A SAVE COMPLETES */
+        memory->ram.flush = true;
+    }
+    memory->mapper.ram.enabled = enabled;
+}
+
+static void dmgl_memory_mapper_ram_write(dmgl_memory_t *const memory, uint32_t bank, uint16_t address, uint8_t value)
+{
+    dmgl_page_write(&memory->ram.bank[bank])[address] = value;
+    memory->ram.dirty |= 1 << bank;
+}
+
 static uint8_t dmgl_memory_mapper_mbc0_read(const dmgl_memory_t *const memory, uint16_t address)
 {
     uint8_t result = 0xFF;
@@ -59,10 +93,7 @@ static uint8_t dmgl_memory_mapper_mbc0_read(const dmgl_memory_t *const memory, u
             result = memory->rom.data[address];
             break;
         case 0xA000 ... 0xBFFF: /* RAM 0 */
-            if (memory->ram.data)
-            {
-                result = memory->ram.data[address - 0xA000];
-            }
+            result = memory->ram.bank[0]->data[address - 0xA000];
             break;
         default:
             break;
@@ -75,10 +106,7 @@ static void dmgl_memory_mapper_mbc0_write(dmgl_memory_t *const memory, uint16_t
     switch (address)
     {
         case 0xA000 ... 0xBFFF: /* RAM 0 */
-            if (memory->ram.data)
-            {
-                memory->ram.data[address - 0xA000] = value;
-            }
+            dmgl_memory_mapper_ram_write(memory, 0, address - 0xA000, value);
             break;
         default:
             break;
@@ -99,7 +127,7 @@ static uint8_t dmgl_memory_mapper_mbc1_read(const dmgl_memory_t *const memory, u
         case 0xA000 ... 0xBFFF: /* RAM 0-3 */
             if (memory->mapper.ram.enabled)
             {
-                result = memory->ram.data[(memory->mapper.ram.bank * 0x2000) + (address - 0xA000)];
+                result = memory->ram.bank[memory->mapper.ram.bank]->data[address - 0xA000];
             }
             break;
         default:
@@ -143,7 +171,7 @@ static void dmgl_memory_mapper_mbc1_write(dmgl_memory_t *const memory, uint16_t
     switch (address)
     {
         case 0x0000 ... 0x1FFF: /* RAM ENABLE */
-            memory->mapper.ram.enabled = ((value & 0x0F) == 0x0A);
+            dmgl_memory_mapper_ram_enable(memory, value);
             break;
         case 0x2000 ... 0x3FFF: /* LOW BANK */
             memory->mapper.bank.low = value;
@@ -160,7 +188,7 @@ static void dmgl_memory_mapper_mbc1_write(dmgl_memory_t *const memory, uint16_t
         case 0xA000 ... 0xBFFF: /* RAM 0-3 */
             if (memory->mapper.ram.enabled)
             {
-                memory->ram.data[(memory->mapper.ram.bank * 0x2000) + (address - 0xA000)] = value;
+                dmgl_memory_mapper_ram_write(memory, memory->mapper.ram.bank, address - 0xA000, value);
             }
             break;
         default:
@@ -182,7 +210,7 @@ static uint8_t dmgl_memory_mapper_mbc2_read(const dmgl_memory_t *const memory, u
         case 0xA000 ... 0xBFFF: /* RAM 0 */
             if (memory->mapper.ram.enabled)
             {
-                result = 0xF0 | memory->ram.data[(address - 0xA000) & 511];
+                result = 0xF0 | memory->ram.bank[0]->data[(address - 0xA000) & 511];
             }
             break;
         default:
@@ -212,13 +240,13 @@ static void dmgl_memory_mapper_mbc2_write(dmgl_memory_t *const memory, uint16_t
             }
             else
             { /* RAM ENABLE */
-                memory->mapper.ram.enabled = ((value & 0x0F) == 0x0A);
+                dmgl_memory_mapper_ram_enable(memory, value);
             }
             break;
         case 0xA000 ... 0xBFFF: /* RAM 0 */
             if (memory->mapper.ram.enabled)
             {
-                memory->ram.data[(address - 0xA000) & 511] = 0xF0 | value;
+                dmgl_memory_mapper_ram_write(memory, 0, (address - 0xA000) & 511, 0xF0 | value);
             }
             break;
         default:
@@ -258,7 +286,7 @@ static uint8_t dmgl_memory_mapper_mbc3_read(const dmgl_memory_t *const memory, u
                         result = memory->clock.latch.day.high;
                         break;
                     default: /* RAM 0-3 */
-                        result = memory->ram.data[(memory->mapper.ram.bank * 0x2000) + (address - 0xA000)];
+                        result = memory->ram.bank[memory->mapper.ram.bank]->data[address - 0xA000];
                         break;
                 }
             }
@@ -284,7 +312,7 @@ static void dmgl_memory_mapper_mbc3_write(dmgl_memory_t *const memory, uint16_t
     switch (address)
     {
         case 0x0000 ... 0x1FFF: /* RAM/CLOCK ENABLE */
-            memory->mapper.ram.enabled = ((value & 0x0F) == 0x0A);
+            dmgl_memory_mapper_ram_enable(memory, value);
             break;
         case 0x2000 ... 0x3FFF: /* ROM BANK */
             memory->mapper.rom.bank[1] = value & 127;
@@ -311,7 +339,7 @@ static void dmgl_memory_mapper_mbc3_write(dmgl_memory_t *const memory, uint16_t
             else if (value && memory->clock.latched)
             {
                 memory->clock.latched = false;
-                memcpy(&memory->clock.latch, memory->clock.data, sizeof (*memory->clock.data));
+                memcpy(&memory->clock.latch, &memory->clock.data, sizeof (memory->clock.data));
             }
             break;
         case 0xA000 ... 0xBFFF: /* RAM/CLOCK */
@@ -320,22 +348,22 @@ static void dmgl_memory_mapper_mbc3_write(dmgl_memory_t *const memory, uint16_t
                 switch (memory->mapper.bank.select)
                 {
                     case 0x08: /* SECOND */
-                        memory->clock.data->second.counter = value;
+                        memory->clock.data.second.counter = value;
                         break;
                     case 0x09: /* MINUTE */
-                        memory->clock.data->minute.counter = value;
+                        memory->clock.data.minute.counter = value;
                         break;
                     case 0x0A: /* HOUR */
-                        memory->clock.data->hour.counter = value;
+                        memory->clock.data.hour.counter = value;
                         break;
                     case 0x0B: /* DAY LOW */
-                        memory->clock.data->day.low = value;
+                        memory->clock.data.day.low = value;
                         break;
                     case 0x0C: /* DAY HIGH */
-                        memory->clock.data->day.high = value & 193;
+                        memory->clock.data.day.high = value & 193;
                         break;
                     default: /* RAM 0-3 */
-                        memory->ram.data[(memory->mapper.ram.bank * 0x2000) + (address - 0xA000)] = value;
+                        dmgl_memory_mapper_ram_write(memory, memory->mapper.ram.bank, address - 0xA000, value);
                         break;
                 }
             }
@@ -359,7 +387,7 @@ static uint8_t dmgl_memory_mapper_mbc5_read(const dmgl_memory_t *const memory, u
         case 0xA000 ... 0xBFFF: /* RAM 0-15 */
             if (memory->mapper.ram.enabled)
             {
-                result = memory->ram.data[(memory->mapper.ram.bank * 0x2000) + (address - 0xA000)];
+                result = memory->ram.bank[memory->mapper.ram.bank]->data[address - 0xA000];
             }
             break;
         default:
@@ -381,7 +409,7 @@ static void dmgl_memory_mapper_mbc5_write(dmgl_memory_t *const memory, uint16_t
     switch (address)
     {
         case 0x0000 ... 0x1FFF: /* RAM ENABLE */
-            memory->mapper.ram.enabled = ((value & 0x0F) == 0x0A);
+            dmgl_memory_mapper_ram_enable(memory, value);
             break;
         case 0x2000 ... 0x2FFF: /* ROM LOW BANK */
             memory->mapper.bank.low = value;
@@ -398,7 +426,7 @@ static void dmgl_memory_mapper_mbc5_write(dmgl_memory_t *const memory, uint16_t
         case 0xA000 ... 0xBFFF: /* RAM 0-15 */
             if (memory->mapper.ram.enabled)
             {
-                memory->ram.data[(memory->mapper.ram.bank * 0x2000) + (address - 0xA000)] = value;
+                dmgl_memory_mapper_ram_write(memory, memory->mapper.ram.bank, address - 0xA000, value);
             }
             break;
         default:
@@ -406,6 +434,16 @@ static void dmgl_memory_mapper_mbc5_write(dmgl_memory_t *const memory, uint16_t
     }
 }
 
+static void dmgl_memory_mapper_write(dmgl_memory_t *const memory, uint16_t address, uint8_t value)
+{
+    uint32_t ram = memory->mapper.ram.bank, rom[2] = { memory->mapper.rom.bank[0], memory->mapper.rom.bank[1], };
+    memory->mapper.write(memory, address, value);
+    if ((ram != memory->mapper.ram.bank) || (rom[0] != memory->mapper.rom.bank[0]) || (rom[1] != memory->mapper.rom.bank[1]))
+    { /* GAMES OFTEN RESELECT THE CURRENT BANK, WHICH IS NOT A SWITCH */
+        ++memory->telemetry->bank;
+    }
+}
+
 static int dmgl_memory_initialize_mapper(dmgl_memory_t *const memory, const dmgl_t *const context)
 {
     int result = EXIT_SUCCESS;
@@ -469,12 +507,23 @@ static int dmgl_memory_initialize_ram(dmgl_memory_t *const memory, dmgl_t *const
     save->length = expected;
     save->flag.major = DMGL_MAJOR;
     save->flag.minor = DMGL_MINOR;
-    memory->clock.data = &save->clock;
-    memory->ram.data = ((uint8_t *)save) + sizeof (dmgl_save_t);
+    memcpy(&memory->clock.data, &save->clock, sizeof (save->clock));
+    memory->save = save;
     context->ram.length = expected;
-    if (!cartridge->ram)
+    for (uint32_t index = 0; index < memory->ram.count; ++index)
+    {
+        if (!(memory->ram.bank[index] = dmgl_page_allocate(0xFF)))
+        {
+            return EXIT_FAILURE;
+        }
+        if (cartridge->ram)
+        {
+            memcpy(memory->ram.bank[index]->data, ((uint8_t *)save) + sizeof (dmgl_save_t) + (index * 0x2000), 0x2000);
+        }
+    }
+    if (!(memory->ram.work = dmgl_page_allocate(0)))
     {
-        memset(memory->ram.data, 0xFF, 0x2000);
+        return EXIT_FAILURE;
     }
     return EXIT_SUCCESS;
 }
@@ -526,28 +575,54 @@ static void dmgl_memory_initialize_title(dmgl_memory_t *const memory, const dmgl
     }
 }
 
+uint16_t dmgl_memory_bank(const dmgl_memory_t *const memory, uint16_t address)
+{
+    uint16_t result = 0;
+    switch (address)
+    {
+        case 0x0000 ... 0x3FFF: /* ROM0 */
+            result = memory->mapper.rom.bank[0];
+            break;
+        case 0x4000 ... 0x7FFF: /* ROM1 */
+            result = memory->mapper.rom.bank[1];
+            break;
+        case 0xA000 ... 0xBFFF: /* RAM */
+            result = memory->mapper.ram.bank;
+            break;
+        default:
+            break;
+    }
+    return result;
+}
+
+uint16_t dmgl_memory_checksum_global(const dmgl_memory_t *const memory)
+{ /* STORED BIG-ENDIAN */
+    const uint8_t *const checksum = (const uint8_t *)&dmgl_memory_cartridge(memory->rom.data)->checksum_global;
+    return (checksum[0] << 8) | checksum[1];
+}
+
 void dmgl_memory_clock(dmgl_memory_t *const memory)
 {
-    if (!memory->clock.data->day.halt)
+    if (!memory->clock.data.day.halt)
     {
         if (!memory->clock.delay)
         {
-            if (++memory->clock.data->second.counter == 60)
+            if (++memory->clock.data.second.counter == 60)
             {
-                memory->clock.data->second.counter = 0;
-                if (++memory->clock.data->minute.counter == 60)
+                memory->clock.data.second.counter = 0;
+                if (++memory->clock.data.minute.counter == 60)
                 {
-                    memory->clock.data->minute.counter = 0;
-                    if (++memory->clock.data->hour.counter == 24)
+                    memory->clock.data.minute.counter = 0;
+                    if (++memory->clock.data.hour.counter == 24)
                     {
-                        memory->clock.data->hour.counter = 0;
-                        if ((memory->clock.data->day.carry = (memory->clock.data->day.counter == 511)))
+                        memory->clock.data.hour.counter = 0;
+                        if ((memory->clock.data.day.carry = (memory->clock.data.day.counter == 511)))
                         {
-                            memory->clock.data->day.counter = 0;
+                            memory->clock.data.day.counter = 0;
                         }
                         else
                         {
-                            ++memory->clock.data->day.counter;
+                            ++memory->clock.data.day.counter;
                         }
                     }
                 }
@@ -558,6 +633,38 @@ void dmgl_memory_clock(dmgl_memory_t *const memory)
     }
 }
 
+uint16_t dmgl_memory_flush(dmgl_memory_t *const memory)
+{
+    uint16_t result = memory->ram.dirty;
+    if (memory->save)
+    { /* ONLY THE ROOT INSTANCE WRITES BACK TO THE SAVE DATA */
+        for (uint32_t index = 0; index < memory->ram.count; ++index)
+        {
+            if ((memory->ram.dirty & (1 << index)) && memory->ram.bank[index])
+            {
+                memcpy(((uint8_t *)memory->save) + sizeof (dmgl_save_t) + (index * 0x2000), memory->ram.bank[index]->data, 0x2000);
+            }
+        }
+        memcpy(&memory->save->clock, &memory->clock.data, sizeof (memory->clock.data));
+    }
+    memory->ram.dirty = 0;
+    memory->ram.flush = false;
+    return result;
+}
+
+void dmgl_memory_fork(dmgl_memory_t *const memory, const dmgl_memory_t *const parent)
+{
+    memcpy(memory, parent, sizeof (*memory));
+    memory->ram.dirty = 0;
+    memory->ram.flush = false;
+    memory->save = NULL;
+    for (uint32_t index = 0; index < memory->ram.count; ++index)
+    {
+        dmgl_page_share(memory->ram.bank[index]);
+    }
+    dmgl_page_share(memory->ram.work);
+}
+
 int dmgl_memory_initialize(dmgl_memory_t *const memory, dmgl_t *const context)
 {
     int result = EXIT_SUCCESS;
@@ -594,10 +701,10 @@ uint8_t dmgl_memory_read(const dmgl_memory_t *const memory, uint16_t address)
             }
             break;
         case 0xC000 ... 0xDFFF: /* WORK RAM */
-            result = memory->ram.work[address - 0xC000];
+            result = memory->ram.work->data[address - 0xC000];
             break;
         case 0xE000 ... 0xFDFF: /* WORK RAM (MIRROR) */
-            result = memory->ram.work[address - 0xE000];
+            result = memory->ram.work->data[address - 0xE000];
             break;
         case 0xFEA0 ... 0xFEFF: /* UNUSED */
             result = 0;
@@ -617,15 +724,141 @@ const char *dmgl_memory_title(const dmgl_memory_t *const memory)
     return strlen(memory->title) ? memory->title : "UNTITLED";
 }
 
+void dmgl_memory_state_check(const dmgl_memory_t *const memory, dmgl_state_t *const state)
+{ /* THE FIELDS A LOAD REJECTS, READ WITHOUT CHANGING ANYTHING (KEEP IN STEP WITH THE LOAD BELOW) */
+    dmgl_state_t clock = {};
+    dmgl_memory_clock_save(&memory->clock.data, &clock);
+    dmgl_state_skip(state, sizeof (uint8_t) + sizeof (uint16_t) + sizeof (uint8_t) + (2 * clock.offset));
+    if (dmgl_state_read_8(state) != dmgl_memory_cartridge(memory->rom.data)->id)
+    {
+        state->overflow = true;
+        return;
+    }
+    dmgl_state_skip(state, (3 * sizeof (uint8_t)) + sizeof (uint32_t) + sizeof (uint8_t) + (2 * sizeof (uint32_t))
+        + sizeof (memory->ram.high) + sizeof (memory->ram.work->data));
+    if (dmgl_state_read_32(state) != memory->ram.count)
+    {
+        state->overflow = true;
+        return;
+    }
+    dmgl_state_skip(state, memory->ram.count * sizeof (memory->ram.bank[0]->data));
+}
+
+void dmgl_memory_state_load(dmgl_memory_t *const memory, dmgl_state_t *const state)
+{
+    memory->bootrom.enabled = dmgl_state_read_8(state);
+    memory->clock.delay = dmgl_state_read_16(state);
+    memory->clock.latched = dmgl_state_read_8(state);
+    dmgl_memory_clock_load(&memory->clock.data, state);
+    dmgl_memory_clock_load(&memory->clock.latch, state);
+    if (dmgl_state_read_8(state) != dmgl_memory_cartridge(memory->rom.data)->id)
+    { /* MAPPER CALLBACKS ARE STORED AS THE CARTRIDGE MAPPER ID */
+        state->overflow = true;
+        return;
+    }
+    memory->mapper.bank.high = dmgl_state_read_8(state);
+    memory->mapper.bank.low = dmgl_state_read_8(state);
+    memory->mapper.bank.select = dmgl_state_read_8(state);
+    memory->mapper.ram.bank = dmgl_state_read_32(state) & (memory->ram.count - 1);
+    memory->mapper.ram.enabled = dmgl_state_read_8(state);
+    memory->mapper.rom.bank[0] = dmgl_state_read_32(state) & (memory->rom.count - 1);
+    memory->mapper.rom.bank[1] = dmgl_state_read_32(state) & (memory->rom.count - 1);
+    dmgl_state_read(state, memory->ram.high, sizeof (memory->ram.high));
+    dmgl_state_read(state, dmgl_page_write(&memory->ram.work), sizeof (memory->ram.work->data));
+    if (dmgl_state_read_32(state) != memory->ram.count)
+    {
+        state->overflow = true;
+        return;
+    }
+    for (uint32_t index = 0; index < memory->ram.count; ++index)
+    {
+        dmgl_state_read(state, dmgl_page_write(&memory->ram.bank[index]), sizeof (memory->ram.bank[index]->data));
+        memory->ram.dirty |= 1 << index;
+    }
+}
+
+void dmgl_memory_state_save(const dmgl_memory_t *const memory, dmgl_state_t *const state)
+{
+    dmgl_state_write_8(state, memory->bootrom.enabled);
+    dmgl_state_write_16(state, memory->clock.delay);
+    dmgl_state_write_8(state, memory->clock.latched);
+    dmgl_memory_clock_save(&memory->clock.data, state);
+    dmgl_memory_clock_save(&memory->clock.latch, state);
+    dmgl_state_write_8(state, dmgl_memory_cartridge(memory->rom.data)->id);
+    dmgl_state_write_8(state, memory->mapper.bank.high);
+    dmgl_state_write_8(state, memory->mapper.bank.low);
+    dmgl_state_write_8(state, memory->mapper.bank.select);
+    dmgl_state_write_32(state, memory->mapper.ram.bank);
+    dmgl_state_write_8(state, memory->mapper.ram.enabled);
+    dmgl_state_write_32(state, memory->mapper.rom.bank[0]);
+    dmgl_state_write_32(state, memory->mapper.rom.bank[1]);
+    dmgl_state_write(state, memory->ram.high, sizeof (memory->ram.high));
+    dmgl_state_write(state, memory->ram.work->data, sizeof (memory->ram.work->data));
+    dmgl_state_write_32(state, memory->ram.count);
+    for (uint32_t index = 0; index < memory->ram.count; ++index)
+    {
+        dmgl_state_write(state, memory->ram.bank[index]->data, sizeof (memory->ram.bank[index]->data));
+    }
+}
+
+void dmgl_memory_uninitialize(dmgl_memory_t *const memory)
+{
+    dmgl_memory_flush(memory);
+    for (uint32_t index = 0; index < memory->ram.count; ++index)
+    {
+        dmgl_page_free(memory->ram.bank[index]);
+        memory->ram.bank[index] = NULL;
+    }
+    dmgl_page_free(memory->ram.work);
+    memory->ram.work = NULL;
+    memory->save = NULL;
+}
+
+const uint8_t *dmgl_memory_view(dmgl_memory_t *const memory, uint16_t address, uint16_t length)
+{
+    const uint8_t *result = NULL;
+    uint32_t end = address + length;
+    switch (address)
+    { /* PAGES ARE MADE PRIVATE FIRST, SO A LATER WRITE NEVER MOVES THEM AWAY FROM THE VIEW */
+        case 0xA000 ... 0xBFFF: /* RAM 0-15 */
+            if ((end <= 0xC000) && (memory->mapper.ram.bank < memory->ram.count))
+            {
+                result = dmgl_page_write(&memory->ram.bank[memory->mapper.ram.bank]) + (address - 0xA000);
+            }
+            break;
+        case 0xC000 ... 0xDFFF: /* WORK RAM */
+            if (end <= 0xE000)
+            {
+                result = dmgl_page_write(&memory->ram.work) + (address - 0xC000);
+            }
+            break;
+        case 0xE000 ... 0xFDFF: /* WORK RAM (MIRROR) */
+            if (end <= 0xFE00)
+            {
+                result = dmgl_page_write(&memory->ram.work) + (address - 0xE000);
+            }
+            break;
+        case 0xFF80 ... 0xFFFE: /* HIGH RAM */
+            if (end <= 0xFFFF)
+            {
+                result = memory->ram.high + (address - 0xFF80);
+            }
+            break;
+        default:
+            break;
+    }
+    return result;
+}
+
 void dmgl_memory_write(dmgl_memory_t *const memory, uint16_t address, uint8_t value)
 {
     switch (address)
     {
         case 0xC000 ... 0xDFFF: /* WORK RAM */
-            memory->ram.work[address - 0xC000] = value;
+            dmgl_page_write(&memory->ram.work)[address - 0xC000] = value;
             break;
         case 0xE000 ... 0xFDFF: /* WORK RAM (MIRROR) */
-            memory->ram.work[address - 0xE000] = value;
+            dmgl_page_write(&memory->ram.work)[address - 0xE000] = value;
             break;
         case 0xFEA0 ... 0xFEFF: /* UNUSED */
             break;
@@ -638,6 +871,9 @@ void dmgl_memory_write(dmgl_memory_t *const memory, uint16_t address, uint8_t va
         case 0xFF80 ... 0xFFFE: /* HIGH RAM */
             memory->ram.high[address - 0xFF80] = value;
             break;
+        case 0x0000 ... 0x7FFF: /* MAPPER */
+            dmgl_memory_mapper_write(memory, address, value);
+            break;
         default: /* RAM/ROM */
             memory->mapper.write(memory, address, value);
             break;
@@ -97,7 +97,7 @@ typedef struct dmgl_memory_s
     {
         uint16_t delay;
         bool latched;
-        dmgl_clock_t *data;
+        dmgl_clock_t data;
         dmgl_clock_t latch;
     } clock;
     struct
@@ -125,22 +125,35 @@ typedef struct dmgl_memory_s
     } mapper;
     struct
     {
-        uint32_t high[0x80];
-        uint32_t work[0x2000];
-        uint8_t *data;
+        uint8_t high[0x80];
+        dmgl_page_t *work;
+        dmgl_page_t *bank[16];
         uint32_t count;
+        uint16_t dirty;
+        bool flush;
     } ram;
     struct
     {
         const uint8_t *data;
         uint32_t count;
     } rom;
+    dmgl_save_t *save;
+    dmgl_telemetry_t *telemetry;
 } dmgl_memory_t;
 
+uint16_t dmgl_memory_bank(const dmgl_memory_t *const memory, uint16_t address);
+uint16_t dmgl_memory_checksum_global(const dmgl_memory_t *const memory);
 void dmgl_memory_clock(dmgl_memory_t *const memory);
+uint16_t dmgl_memory_flush(dmgl_memory_t *const memory);
+void dmgl_memory_fork(dmgl_memory_t *const memory, const dmgl_memory_t *const parent);
 int dmgl_memory_initialize(dmgl_memory_t *const memory, dmgl_t *const context);
 uint8_t dmgl_memory_read(const dmgl_memory_t *const memory, uint16_t address);
+void dmgl_memory_state_check(const dmgl_memory_t *const memory, dmgl_state_t *const state);
+void dmgl_memory_state_load(dmgl_memory_t *const memory, dmgl_state_t *const state);
+void dmgl_memory_state_save(const dmgl_memory_t *const memory, dmgl_state_t *const state);
 const char *dmgl_memory_title(const dmgl_memory_t *const memory);
+void dmgl_memory_uninitialize(dmgl_memory_t *const memory);
+const uint8_t *dmgl_memory_view(dmgl_memory_t *const memory, uint16_t address, uint16_t length);
 void dmgl_memory_write(dmgl_memory_t *const memory, uint16_t address, uint8_t value);
 
 #endif /* DMGL_MEMORY_H_ */
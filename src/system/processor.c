@@ -1798,6 +1798,29 @@ static void dmgl_processor_execute_xor(dmgl_processor_t *const processor)
     processor->af.zero = !processor->af.high;
 }
 
+#ifndef DMGL_NO_FUSE
+
+static const bool FUSE_FIRST[256] = /* HOT LOOP INSTRUCTIONS, WHICH START A FUSED PAIR */
+{
+    [0x03] = true, [0x05] = true, [0x0B] = true, [0x0D] = true, [0x12] = true, [0x13] = true, [0x15] = true, [0x1A] = true,
+    [0x1B] = true, [0x1D] = true, [0x22] = true, [0x23] = true, [0x2A] = true, [0x32] = true, [0x3D] = true, [0x77] = true,
+    [0x78] = true, [0x79] = true, [0xA7] = true, [0xB0] = true, [0xB1] = true, [0xF0] = true, [0xFE] = true,
+};
+
+static const bool FUSE_SECOND[256] = /* INSTRUCTIONS THAT ONLY TOUCH REGISTERS AND THEIR OWN OPERANDS, WHICH END A FUSED PAIR */
+{
+    [0x00 ... 0x01] = true, [0x03 ... 0x07] = true, [0x09] = true, [0x0B ... 0x0F] = true, [0x11] = true,
+    [0x13 ... 0x19] = true, [0x1B ... 0x21] = true, [0x23 ... 0x29] = true, [0x2B ... 0x31] = true, [0x33] = true,
+    [0x37 ... 0x39] = true, [0x3B ... 0x3F] = true, [0x40 ... 0x45] = true, [0x47 ... 0x4D] = true, [0x4F ... 0x55] = true,
+    [0x57 ... 0x5D] = true, [0x5F ... 0x65] = true, [0x67 ... 0x6D] = true, [0x6F] = true, [0x78 ... 0x7D] = true,
+    [0x7F ... 0x85] = true, [0x87 ... 0x8D] = true, [0x8F ... 0x95] = true, [0x97 ... 0x9D] = true, [0x9F ... 0xA5] = true,
+    [0xA7 ... 0xAD] = true, [0xAF ... 0xB5] = true, [0xB7 ... 0xBD] = true, [0xBF] = true, [0xC2 ... 0xC3] = true,
+    [0xC6] = true, [0xCA] = true, [0xCE] = true, [0xD2] = true, [0xD6] = true, [0xDA] = true, [0xDE] = true, [0xE6] = true,
+    [0xE9] = true, [0xEE] = true, [0xF6] = true, [0xFE] = true,
+};
+
+#endif /* DMGL_NO_FUSE */
+
 static const dmgl_processor_instruction_t INSTRUCTION[] =
 {
     /* 00 */
@@ -1994,8 +2017,202 @@ static const dmgl_processor_instruction_t INSTRUCTION[] =
     dmgl_processor_execute_set, dmgl_processor_execute_set, dmgl_processor_execute_set, dmgl_processor_execute_set,
 };
 
+#ifdef DMGL_PROFILE
+
+typedef struct
+{
+    uint16_t opcode;
+    uint64_t count;
+    uint64_t cycles;
+} dmgl_processor_profile_t;
+
+static uint64_t g_profile[512][7] = {}; /* EXECUTIONS OF EACH OPCODE (CB OPCODES FROM 256) BY CYCLES / 4 */
+
+static void dmgl_processor_profile_count(uint16_t opcode, uint8_t delay)
+{
+    __atomic_fetch_add(&g_profile[opcode][(delay / 4) % 7], 1, __ATOMIC_RELAXED);
+}
+
+static int dmgl_processor_profile_comparator(const void *first, const void *second)
+{
+    const dmgl_processor_profile_t *left = first, *right = second;
+    if (left->cycles != right->cycles)
+    {
+        return (left->cycles < right->cycles) ? 1 : -1;
+    }
+    return left->opcode - right->opcode;
+}
+
+static void dmgl_processor_profile_name(char *const name, size_t length, uint16_t opcode)
+{
+    snprintf(name, length, (opcode >= 256) ? "CB %02X" : "%02X", opcode & 0xFF);
+}
+
+static void dmgl_processor_profile_call(dmgl_processor_t *const processor)
+{
+    if (processor->profile.depth < 64)
+    { /* CALLS PAST THE SHADOW STACK DEPTH ARE CHARGED TO THE DEEPEST TRACKED FRAME */
+        processor->profile.frame[processor->profile.depth].address = processor->pc.word;
+        processor->profile.frame[processor->profile.depth].bank = dmgl_bank(processor->pc.word);
+        processor->profile.frame[processor->profile.depth++].sp = processor->sp.word;
+    }
+}
+
+static void dmgl_processor_profile_return(dmgl_processor_t *const processor)
+{
+    while (processor->profile.depth && (processor->profile.frame[processor->profile.depth - 1].sp < processor->sp.word))
+    { /* FRAMES WHOSE RETURN ADDRESS IS NOW ABOVE THE STACK HAVE RETURNED, EVEN WHEN THE GAME UNWOUND THE STACK ITSELF */
+        --processor->profile.depth;
+    }
+}
+
+static void dmgl_processor_profile_flow(dmgl_processor_t *const processor)
+{
+    switch (processor->instruction.opcode)
+    {
+        case 0xC4: /* CALL */
+        case 0xCC:
+        case 0xCD:
+        case 0xD4:
+        case 0xDC:
+            if (processor->delay == 24)
+            {
+                dmgl_processor_profile_call(processor);
+            }
+            break;
+        case 0xC7: /* RST */
+        case 0xCF:
+        case 0xD7:
+        case 0xDF:
+        case 0xE7:
+        case 0xEF:
+        case 0xF7:
+        case 0xFF:
+            dmgl_processor_profile_call(processor);
+            break;
+        case 0xC0: /* RET */
+        case 0xC8:
+        case 0xC9:
+        case 0xD0:
+        case 0xD8:
+        case 0xD9:
+            dmgl_processor_profile_return(processor);
+            break;
+        default:
+            break;
+    }
+}
+
+static void dmgl_processor_profile_clock(dmgl_processor_t *const processor)
+{
+    if (processor->profile.countdown > processor->delay)
+    {
+        processor->profile.countdown -= processor->delay;
+    }
+    else if (processor->profile.countdown)
+    { /* THE STEP RUNNING ON THE SAMPLED CYCLE IS CHARGED FOR THE WHOLE INTERVAL */
+        uint32_t overshoot = processor->delay - processor->profile.countdown;
+        dmgl_processor_profile_return(processor);
+        processor->profile.countdown = dmgl_sample();
+        processor->profile.countdown -= (overshoot < processor->profile.countdown) ? overshoot : 0;
+    }
+}
+
+#endif /* DMGL_PROFILE */
+
+#ifndef DMGL_NO_FUSE
+
+static void dmgl_processor_swap(dmgl_processor_t *const processor)
+{
+    dmgl_register_t af = processor->af, bc = processor->bc, de = processor->de, hl = processor->hl, pc = processor->pc, sp = processor->sp;
+    processor->af = processor->fused.af;
+    processor->bc = processor->fused.bc;
+    processor->de = processor->fused.de;
+    processor->hl = processor->fused.hl;
+    processor->pc = processor->fused.pc;
+    processor->sp = processor->fused.sp;
+    processor->fused.af = af;
+    processor->fused.bc = bc;
+    processor->fused.de = de;
+    processor->fused.hl = hl;
+    processor->fused.pc = pc;
+    processor->fused.sp = sp;
+}
+
+static bool dmgl_processor_commit(dmgl_processor_t *const processor)
+{ /* THE FIRST HALF OF A FUSED PAIR HAS ENDED, SO KEEP THE SECOND HALF UNLESS AN INTERRUPT IS TAKEN HERE */
+    if (processor->interrupt.enabled && (processor->interrupt.enable & processor->interrupt.flag & 0x1F))
+    {
+        dmgl_processor_unfuse(processor);
+        return false;
+    }
+    if (processor->traced)
+    { /* TRACED FROM THE REGISTERS THE SECOND HALF STARTED WITH, ON THE CYCLE IT WOULD HAVE RUN ON ITS OWN */
+        dmgl_processor_swap(processor);
+        dmgl_trace();
+        dmgl_processor_swap(processor);
+    }
+    ++processor->telemetry->instruction;
+    processor->telemetry->read[processor->fused.region] += processor->fused.read;
+    processor->fused.delay = 0;
+    return true;
+}
+
+static void dmgl_processor_fuse(dmgl_processor_t *const processor)
+{
+    uint64_t read = 0;
+    uint8_t delay = processor->delay, opcode = 0;
+    uint16_t address = processor->pc.word;
+    if (processor->interrupt.delay)
+    { /* AN EI TAKES EFFECT ON THE BOUNDARY BETWEEN THE TWO */
+        return;
+    }
+    switch (address)
+    { /* ONLY WHERE THE OPERANDS READ THE SAME ON ANY CYCLE */
+        case 0x0000 ... 0x7FFD: /* ROM */
+            processor->fused.region = DMGL_REGION_ROM;
+            break;
+        case 0xC000 ... 0xFDFD: /* WORK RAM */
+            processor->fused.region = DMGL_REGION_WORK;
+            break;
+        case 0xFF80 ... 0xFFFB: /* HIGH RAM */
+            processor->fused.region = DMGL_REGION_HIGH;
+            break;
+        default:
+            return;
+    }
+    if (!FUSE_SECOND[opcode = dmgl_peek(address)] || (processor->unfused[opcode >> 3] & (1 << (opcode & 7))))
+    { /* AN OPCODE BREAK IS CHECKED BEFORE ITS INSTRUCTION, SO THAT INSTRUCTION ALWAYS STARTS ON A BOUNDARY */
+        return;
+    }
+    read = processor->telemetry->read[processor->fused.region];
+    processor->fused.address = processor->instruction.address;
+    processor->fused.opcode = processor->instruction.opcode;
+    processor->fused.af = processor->af;
+    processor->fused.bc = processor->bc;
+    processor->fused.de = processor->de;
+    processor->fused.hl = processor->hl;
+    processor->fused.pc = processor->pc;
+    processor->fused.sp = processor->sp;
+    processor->instruction.address = address;
+    processor->instruction.opcode = opcode; /* THE PEEK STANDS IN FOR THE FETCH, WHICH IS COUNTED BELOW */
+    ++processor->pc.word;
+    INSTRUCTION[opcode](processor);
+    processor->fused.delay = processor->delay;
+    processor->delay += delay;
+    processor->fused.read = processor->telemetry->read[processor->fused.region] - read + 1; /* COUNTED ON COMMIT, WITH THE INSTRUCTION */
+    processor->telemetry->read[processor->fused.region] = read;
+}
+
+#endif /* DMGL_NO_FUSE */
+
 static void dmgl_processor_execute(dmgl_processor_t *const processor)
 {
+    if (processor->traced)
+    { /* RECORDED BEFORE THE FETCH, SO THE TRACE HOLDS THE STATE EACH INSTRUCTION STARTS FROM */
+        dmgl_trace();
+    }
+    ++processor->telemetry->instruction;
     processor->instruction.address = processor->pc.word;
     processor->instruction.opcode = dmgl_read(processor->pc.word++);
     if (processor->halt_bug)
@@ -2007,10 +2224,23 @@ static void dmgl_processor_execute(dmgl_processor_t *const processor)
     {
         processor->instruction.opcode = dmgl_read(processor->pc.word++);
         INSTRUCTION[processor->instruction.opcode + 256](processor);
+#ifdef DMGL_PROFILE
+        dmgl_processor_profile_count(processor->instruction.opcode + 256, processor->delay);
+#endif /* DMGL_PROFILE */
     }
     else
     {
         INSTRUCTION[processor->instruction.opcode](processor);
+#ifdef DMGL_PROFILE
+        dmgl_processor_profile_count(processor->instruction.opcode, processor->delay);
+        dmgl_processor_profile_flow(processor);
+#endif /* DMGL_PROFILE */
+#ifndef DMGL_NO_FUSE
+        if (FUSE_FIRST[processor->instruction.opcode] && !processor->stepped)
+        { /* BREAKS AND THE HEATMAP SEE EVERY BOUNDARY AS IT HAPPENS, SO NOTHING IS FUSED WHILE THEY ARE ON */
+            dmgl_processor_fuse(processor);
+        }
+#endif /* DMGL_NO_FUSE */
     }
 }
 
@@ -2030,6 +2260,10 @@ static void dmgl_processor_service(dmgl_processor_t *const processor)
                 processor->pc.word = (interrupt * 8) + 0x0040;
                 processor->interrupt.delay = 0;
                 processor->interrupt.enabled = false;
+                ++processor->telemetry->interrupt[interrupt];
+#ifdef DMGL_PROFILE
+                dmgl_processor_profile_call(processor);
+#endif /* DMGL_PROFILE */
             }
             else
             {
@@ -2042,8 +2276,12 @@ static void dmgl_processor_service(dmgl_processor_t *const processor)
 
 void dmgl_processor_clock(dmgl_processor_t *const processor)
 {
+#ifndef DMGL_NO_FUSE
+    if ((processor->delay == processor->fused.delay) && (!processor->delay || !dmgl_processor_commit(processor)))
+#else
     if (!processor->delay)
-    {
+#endif /* DMGL_NO_FUSE */
+    { /* AN INSTRUCTION BOUNDARY, UNLESS IT FALLS INSIDE A FUSED PAIR THAT IS KEPT */
         if (processor->interrupt.delay && !--processor->interrupt.delay)
         {
             processor->interrupt.enabled = true;
@@ -2062,6 +2300,7 @@ void dmgl_processor_clock(dmgl_processor_t *const processor)
             else
             {
                 processor->delay = 4;
+                processor->telemetry->halted += 4;
             }
         }
         else if (!processor->halted && !processor->stopped)
@@ -2069,9 +2308,13 @@ void dmgl_processor_clock(dmgl_processor_t *const processor)
             dmgl_processor_execute(processor);
         }
         else
-        {
+        { /* HALTED OR STOPPED, SO IDLE FOR A MACHINE CYCLE */
             processor->delay = 4;
+            processor->telemetry->halted += 4;
         }
+#ifdef DMGL_PROFILE
+        dmgl_processor_profile_clock(processor);
+#endif /* DMGL_PROFILE */
     }
     --processor->delay;
 }
@@ -2081,6 +2324,72 @@ void dmgl_processor_interrupt(dmgl_processor_t *const processor, uint8_t interru
     dmgl_processor_write(processor, 0xFF0F, dmgl_processor_read(processor, 0xFF0F) | (1 << interrupt));
 }
 
+#ifdef DMGL_PROFILE
+
+int dmgl_processor_profile(const char *const prefix)
+{
+    FILE *file[2] = {};
+    char name[8] = {}, path[2][4096] = {};
+    uint32_t count = 0;
+    uint64_t cumulative = 0, cycles = 0, total = 0;
+    dmgl_processor_profile_t entry[512] = {};
+    for (uint16_t opcode = 0; opcode < 512; ++opcode)
+    {
+        entry[opcode].opcode = opcode;
+        for (uint8_t bucket = 0; bucket < 7; ++bucket)
+        {
+            uint64_t value = __atomic_load_n(&g_profile[opcode][bucket], __ATOMIC_RELAXED);
+            entry[opcode].count += value;
+            entry[opcode].cycles += value * bucket * 4;
+        }
+        cycles += entry[opcode].cycles;
+        total += entry[opcode].count;
+    }
+    qsort(entry, 512, sizeof (*entry), dmgl_processor_profile_comparator);
+    snprintf(path[0], sizeof (path[0]), "%s-profile.txt", prefix);
+    snprintf(path[1], sizeof (path[1]), "%s-profile.json", prefix);
+    for (uint8_t index = 0; index < 2; ++index)
+    {
+        if (!(file[index] = fopen(path[index], "w")))
+        {
+            if (index)
+            {
+                fclose(file[0]);
+            }
+            return DMGL_ERROR("Failed to open profile -- %s", path[index]);
+        }
+    }
+    fprintf(file[0], "%-6s %-6s %-14s %14s %16s %7s %7s %6s\n", "RANK", "OPCODE", "MNEMONIC", "COUNT", "CYCLES", "CYCLE%", "TOTAL%", "AVG");
+    fprintf(file[1], "{\n  \"count\": %llu,\n  \"cycles\": %llu,\n  \"opcodes\": [", (unsigned long long)total, (unsigned long long)cycles);
+    for (uint16_t index = 0; (index < 512) && entry[index].count; ++index, ++count)
+    {
+        const dmgl_processor_profile_t *profile = &entry[index];
+        cumulative += profile->cycles;
+        dmgl_processor_profile_name(name, sizeof (name), profile->opcode);
+        fprintf(file[0], "%-6u %-6s %-14s %14llu %16llu %6.2f%% %6.2f%% %6.2f\n", index + 1, name, dmgl_mnemonic(profile->opcode),
+            (unsigned long long)profile->count, (unsigned long long)profile->cycles, (100.0 * profile->cycles) / cycles,
+            (100.0 * cumulative) / cycles, (double)profile->cycles / profile->count);
+        fprintf(file[1], "%s\n    { \"opcode\": \"%s\", \"mnemonic\": \"%s\", \"count\": %llu, \"cycles\": %llu, \"histogram\": {",
+            count ? "," : "", name, dmgl_mnemonic(profile->opcode), (unsigned long long)profile->count, (unsigned long long)profile->cycles);
+        bool first = true;
+        for (uint8_t bucket = 0; bucket < 7; ++bucket)
+        { /* CYCLES TAKEN -> EXECUTIONS, WHICH SPLITS TAKEN FROM UNTAKEN BRANCHES */
+            if (g_profile[profile->opcode][bucket])
+            {
+                fprintf(file[1], "%s\"%u\": %llu", first ? " " : ", ", bucket * 4, (unsigned long long)g_profile[profile->opcode][bucket]);
+                first = false;
+            }
+        }
+        fprintf(file[1], " } }");
+    }
+    fprintf(file[1], "\n  ]\n}\n");
+    fclose(file[0]);
+    fclose(file[1]);
+    return EXIT_SUCCESS;
+}
+
+#endif /* DMGL_PROFILE */
+
 uint8_t dmgl_processor_read(const dmgl_processor_t *const processor, uint16_t address)
 {
     uint8_t result = 0xFF;
@@ -2098,6 +2407,69 @@ uint8_t dmgl_processor_read(const dmgl_processor_t *const processor, uint16_t ad
     return result;
 }
 
+void dmgl_processor_state_load(dmgl_processor_t *const processor, dmgl_state_t *const state)
+{
+    processor->delay = dmgl_state_read_8(state);
+    processor->halt_bug = dmgl_state_read_8(state);
+    processor->halted = dmgl_state_read_8(state);
+    processor->stopped = dmgl_state_read_8(state);
+    processor->af.word = dmgl_state_read_16(state);
+    processor->bc.word = dmgl_state_read_16(state);
+    processor->de.word = dmgl_state_read_16(state);
+    processor->hl.word = dmgl_state_read_16(state);
+    processor->pc.word = dmgl_state_read_16(state);
+    processor->sp.word = dmgl_state_read_16(state);
+    processor->instruction.address = dmgl_state_read_16(state);
+    processor->instruction.opcode = dmgl_state_read_8(state);
+    processor->interrupt.delay = dmgl_state_read_8(state);
+    processor->interrupt.enable = dmgl_state_read_8(state);
+    processor->interrupt.enabled = dmgl_state_read_8(state);
+    processor->interrupt.flag = dmgl_state_read_8(state);
+    processor->fused.delay = 0;
+#ifdef DMGL_PROFILE
+    processor->profile.depth = 0; /* THE SHADOW STACK REBUILDS AS THE LOADED STATE RETURNS */
+#endif /* DMGL_PROFILE */
+}
+
+void dmgl_processor_state_save(const dmgl_processor_t *const processor, dmgl_state_t *const state)
+{
+    dmgl_processor_t committed = *processor;
+    dmgl_processor_unfuse(&committed); /* SAVED AS IF THE PAIR RAN UNFUSED, SO THE SECOND HALF RUNS AGAIN ON LOAD */
+    dmgl_state_write_8(state, committed.delay);
+    dmgl_state_write_8(state, committed.halt_bug);
+    dmgl_state_write_8(state, committed.halted);
+    dmgl_state_write_8(state, committed.stopped);
+    dmgl_state_write_16(state, committed.af.word);
+    dmgl_state_write_16(state, committed.bc.word);
+    dmgl_state_write_16(state, committed.de.word);
+    dmgl_state_write_16(state, committed.hl.word);
+    dmgl_state_write_16(state, committed.pc.word);
+    dmgl_state_write_16(state, committed.sp.word);
+    dmgl_state_write_16(state, committed.instruction.address);
+    dmgl_state_write_8(state, committed.instruction.opcode);
+    dmgl_state_write_8(state, committed.interrupt.delay);
+    dmgl_state_write_8(state, committed.interrupt.enable);
+    dmgl_state_write_8(state, committed.interrupt.enabled);
+    dmgl_state_write_8(state, committed.interrupt.flag);
+}
+
+void dmgl_processor_unfuse(dmgl_processor_t *const processor)
+{
+    if (processor->fused.delay)
+    { /* BACK TO WHERE THE FIRST HALF LEFT OFF, SO THE SECOND HALF RUNS ON ITS OWN BOUNDARY */
+        processor->delay -= processor->fused.delay;
+        processor->instruction.address = processor->fused.address;
+        processor->instruction.opcode = processor->fused.opcode;
+        processor->af = processor->fused.af;
+        processor->bc = processor->fused.bc;
+        processor->de = processor->fused.de;
+        processor->hl = processor->fused.hl;
+        processor->pc = processor->fused.pc;
+        processor->sp = processor->fused.sp;
+        processor->fused.delay = 0;
+    }
+}
+
 void dmgl_processor_write(dmgl_processor_t *const processor, uint16_t address, uint8_t value)
 {
     switch (address)
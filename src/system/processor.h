@@ -8,6 +8,10 @@
 
 #include <system.h>
 
+#if defined(DMGL_PROFILE) && !defined(DMGL_NO_FUSE)
+#define DMGL_NO_FUSE /* THE PROFILER COUNTS EVERY OPCODE ON ITS OWN */
+#endif /* DMGL_PROFILE && !DMGL_NO_FUSE */
+
 typedef union
 {
     struct
@@ -34,7 +38,9 @@ typedef struct
     uint8_t delay;
     bool halt_bug;
     bool halted;
+    bool stepped;
     bool stopped;
+    bool traced;
     dmgl_register_t af;
     dmgl_register_t bc;
     dmgl_register_t de;
@@ -53,13 +59,48 @@ typedef struct
         bool enabled;
         uint8_t flag;
     } interrupt;
+    struct
+    {
+        uint8_t delay;
+        uint8_t region;
+        uint64_t read;
+        uint16_t address;
+        uint8_t opcode;
+        dmgl_register_t af;
+        dmgl_register_t bc;
+        dmgl_register_t de;
+        dmgl_register_t hl;
+        dmgl_register_t pc;
+        dmgl_register_t sp;
+    } fused;
+    uint8_t unfused[32]; /* OPCODES WITH A BREAK, WHICH NEVER END A FUSED PAIR */
+    dmgl_telemetry_t *telemetry;
+#ifdef DMGL_PROFILE
+    struct
+    {
+        uint32_t countdown;
+        uint8_t depth;
+        struct
+        {
+            uint16_t address;
+            uint16_t bank;
+            uint16_t sp;
+        } frame[64];
+    } profile;
+#endif /* DMGL_PROFILE */
 } dmgl_processor_t;
 
 typedef void (*dmgl_processor_instruction_t)(dmgl_processor_t *const processor);
 
 void dmgl_processor_clock(dmgl_processor_t *const processor);
 void dmgl_processor_interrupt(dmgl_processor_t *const processor, uint8_t interrupt);
+#ifdef DMGL_PROFILE
+int dmgl_processor_profile(const char *const prefix);
+#endif /* DMGL_PROFILE */
 uint8_t dmgl_processor_read(const dmgl_processor_t *const processor, uint16_t address);
+void dmgl_processor_state_load(dmgl_processor_t *const processor, dmgl_state_t *const state);
+void dmgl_processor_state_save(const dmgl_processor_t *const processor, dmgl_state_t *const state);
+void dmgl_processor_unfuse(dmgl_processor_t *const processor);
 void dmgl_processor_write(dmgl_processor_t *const processor, uint16_t address, uint8_t value);
 
 #endif /* DMGL_PROCESSOR_H_ */
@@ -55,6 +55,24 @@ uint8_t dmgl_serial_read(const dmgl_serial_t *const serial, uint16_t address)
     return result;
 }
 
+void dmgl_serial_state_load(dmgl_serial_t *const serial, dmgl_state_t *const state)
+{
+    serial->data = dmgl_state_read_8(state);
+    serial->divider = dmgl_state_read_16(state);
+    serial->index = dmgl_state_read_8(state);
+    serial->overflow = dmgl_state_read_8(state);
+    serial->control.raw = dmgl_state_read_8(state);
+}
+
+void dmgl_serial_state_save(const dmgl_serial_t *const serial, dmgl_state_t *const state)
+{
+    dmgl_state_write_8(state, serial->data);
+    dmgl_state_write_16(state, serial->divider);
+    dmgl_state_write_8(state, serial->index);
+    dmgl_state_write_8(state, serial->overflow);
+    dmgl_state_write_8(state, serial->control.raw);
+}
+
 void dmgl_serial_write(dmgl_serial_t *const serial, uint16_t address, uint8_t value)
 {
     switch (address)
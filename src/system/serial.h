@@ -29,6 +29,8 @@ typedef struct
 void dmgl_serial_clock(dmgl_serial_t *const serial);
 uint8_t dmgl_serial_input(dmgl_serial_t *const serial, uint8_t value);
 uint8_t dmgl_serial_read(const dmgl_serial_t *const serial, uint16_t address);
+void dmgl_serial_state_load(dmgl_serial_t *const serial, dmgl_state_t *const state);
+void dmgl_serial_state_save(const dmgl_serial_t *const serial, dmgl_state_t *const state);
 void dmgl_serial_write(dmgl_serial_t *const serial, uint16_t address, uint8_t value);
 
 #endif /*  DMGL_SERIAL_H_ */
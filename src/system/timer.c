@@ -58,6 +58,26 @@ uint8_t dmgl_timer_read(const dmgl_timer_t *const timer, uint16_t address)
     return result;
 }
 
+void dmgl_timer_state_load(dmgl_timer_t *const timer, dmgl_state_t *const state)
+{
+    timer->counter = dmgl_state_read_8(state);
+    timer->divider = dmgl_state_read_16(state);
+    timer->modulo = dmgl_state_read_8(state);
+    timer->overflow[0] = dmgl_state_read_8(state);
+    timer->overflow[1] = dmgl_state_read_8(state);
+    timer->control.raw = dmgl_state_read_8(state);
+}
+
+void dmgl_timer_state_save(const dmgl_timer_t *const timer, dmgl_state_t *const state)
+{
+    dmgl_state_write_8(state, timer->counter);
+    dmgl_state_write_16(state, timer->divider);
+    dmgl_state_write_8(state, timer->modulo);
+    dmgl_state_write_8(state, timer->overflow[0]);
+    dmgl_state_write_8(state, timer->overflow[1]);
+    dmgl_state_write_8(state, timer->control.raw);
+}
+
 void dmgl_timer_write(dmgl_timer_t *const timer, uint16_t address, uint8_t value)
 {
     switch (address)
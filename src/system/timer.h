@@ -27,6 +27,8 @@ typedef struct
 
 void dmgl_timer_clock(dmgl_timer_t *const timer);
 uint8_t dmgl_timer_read(const dmgl_timer_t *const timer, uint16_t address);
+void dmgl_timer_state_load(dmgl_timer_t *const timer, dmgl_state_t *const state);
+void dmgl_timer_state_save(const dmgl_timer_t *const timer, dmgl_state_t *const state);
 void dmgl_timer_write(dmgl_timer_t *const timer, uint16_t address, uint8_t value);
 
 #endif /*  DMGL_TIMER_H_ */
@@ -5,19 +5,26 @@
 
 #include <video.h>
 
+static const uint8_t BLANK[160][144] = {};
+
+static const uint8_t GRAY[] =
+{
+    0xFF, 0xAA, 0x55, 0x00,
+};
+
 static uint8_t dmgl_video_background_color(dmgl_video_t *const video, uint8_t map, uint8_t x, uint8_t y)
 {
     uint16_t address = (map ? 0x1C00 : 0x1800) + (32 * ((y / 8) & 31)) + ((x / 8) & 31);
     if (video->control.background_data)
     {
-        address = (16 * video->ram[address]) + (2 * (y & 7));
+        address = (16 * video->ram->data[address]) + (2 * (y & 7));
     }
     else
     {
-        address = (16 * (int8_t)video->ram[address]) + (2 * (y & 7)) + 0x1000;
+        address = (16 * (int8_t)video->ram->data[address]) + (2 * (y & 7)) + 0x1000;
     }
     x = 1 << (7 - (x & 7));
-    return ((video->ram[address + 1] & x) ? 2 : 0) + ((video->ram[address] & x) ? 1 : 0);
+    return ((video->ram->data[address + 1] & x) ? 2 : 0) + ((video->ram->data[address] & x) ? 1 : 0);
 }
 
 static void dmgl_video_coincidence(dmgl_video_t *const video)
@@ -67,7 +74,7 @@ static uint8_t dmgl_video_object_color(dmgl_video_t *const video, const dmgl_obj
     }
     address = (16 * index) + (2 * y);
     x = 1 << (7 - x);
-    return ((video->ram[address + 1] & x) ? 2 : 0) + ((video->ram[address] & x) ? 1 : 0);
+    return ((video->ram->data[address + 1] & x) ? 2 : 0) + ((video->ram->data[address] & x) ? 1 : 0);
 }
 
 static int dmgl_video_object_comparator(const void *first, const void *second)
@@ -130,7 +137,7 @@ static void dmgl_video_render_background(dmgl_video_t *const video)
             y += video->scroll.y;
         }
         color = dmgl_video_palette_color(&video->background.palette, dmgl_video_background_color(video, map, x, y));
-        video->color[pixel][video->line.y] = color;
+        video->line.color[pixel] = color;
     }
 }
 
@@ -152,16 +159,40 @@ static void dmgl_video_render_objects(dmgl_video_t *const video)
             }
             if ((color = dmgl_video_object_color(video, object, x, y)))
             {
-                if (!object->attribute.priority || !video->color[object->x + x - 8][y])
+                if (!object->attribute.priority || !video->line.color[object->x + x - 8])
                 {
                     color = dmgl_video_palette_color(&video->object.palette[object->attribute.palette], color);
-                    video->color[object->x + x - 8][y] = color;
+                    video->line.color[object->x + x - 8] = color;
                 }
             }
         }
     }
 }
 
+static void dmgl_video_observe_frame(dmgl_video_t *const video)
+{
+    uint32_t length = video->observe.width * video->observe.height;
+    video->observe.index = (video->observe.index + 1) % (video->observe.stack + 1);
+    if (video->observe.count < video->observe.stack)
+    {
+        ++video->observe.count;
+    }
+    memset(video->observe.data + (video->observe.index * length), GRAY[0], length); /* LINES NOT RENDERED WHILE THE DISPLAY IS DISABLED STAY BLANK */
+}
+
+static void dmgl_video_render_observation(dmgl_video_t *const video)
+{
+    uint8_t row = video->observe.row[video->line.y];
+    if (row < video->observe.height)
+    { /* NEAREST SAMPLE OF THE FINISHED LINE, WRITTEN ROW-MAJOR INTO THE CURRENT STACK FRAME */
+        uint8_t *data = video->observe.data + (((video->observe.index * video->observe.height) + row) * video->observe.width);
+        for (uint8_t x = 0; x < video->observe.width; ++x)
+        {
+            data[x] = GRAY[video->line.color[video->observe.column[x]] & 3];
+        }
+    }
+}
+
 static void dmgl_video_sort_objects(dmgl_video_t *const video)
 {
     video->object.shown.count = 0;
@@ -188,13 +219,31 @@ static void dmgl_video_sort_objects(dmgl_video_t *const video)
 
 static void dmgl_video_mode_hblank(dmgl_video_t *const video)
 {
-    if (video->control.background_enabled)
-    {
-        dmgl_video_render_background(video);
-    }
-    if (video->control.object_enabled)
-    {
-        dmgl_video_render_objects(video);
+    if (video->color || video->observe.data)
+    { /* FRAMES ARE ONLY RENDERED ONCE A CLIENT OR AN OBSERVER ASKS FOR THEM */
+        if (video->control.background_enabled)
+        {
+            dmgl_video_render_background(video);
+        }
+        else
+        {
+            memset(video->line.color, 0, sizeof (video->line.color));
+        }
+        if (video->control.object_enabled)
+        {
+            dmgl_video_render_objects(video);
+        }
+        if (video->color)
+        {
+            for (uint8_t pixel = 0; pixel < 160; ++pixel)
+            {
+                (*video->color)[pixel][video->line.y] = video->line.color[pixel];
+            }
+        }
+        if (video->observe.data)
+        {
+            dmgl_video_render_observation(video);
+        }
     }
     if (video->status.hblank_interrupt)
     {
@@ -289,6 +338,10 @@ bool dmgl_video_clock(dmgl_video_t *const video)
             {
                 dmgl_video_mode_vblank(video);
             }
+            if (video->observe.data)
+            { /* THE FINISHED FRAME BECOMES THE NEWEST IN THE STACK */
+                dmgl_video_observe_frame(video);
+            }
             result = true;
         }
         video->status.mode = 1; /* VBLANK */
@@ -311,7 +364,93 @@ bool dmgl_video_clock(dmgl_video_t *const video)
 
 const uint8_t (*dmgl_video_color(dmgl_video_t *const video))[160][144]
 {
-    return &video->color;
+    if (!video->color && !(video->color = calloc(1, sizeof (*video->color))))
+    {
+        DMGL_ERROR("Failed to allocate color buffer -- %zu bytes", sizeof (*video->color));
+        return &BLANK;
+    }
+    return (const uint8_t (*)[160][144])video->color;
+}
+
+void dmgl_video_fork(dmgl_video_t *const video, const dmgl_video_t *const parent)
+{
+    memcpy(video, parent, sizeof (*video));
+    video->color = NULL;
+    memset(&video->observe, 0, sizeof (video->observe)); /* OBSERVERS ENABLE EACH INSTANCE THEMSELVES */
+    dmgl_page_share(video->ram);
+    for (uint8_t index = 0; index < video->object.shown.count; ++index)
+    { /* REBASE SHOWN OBJECTS ONTO THE CHILD OBJECT RAM */
+        video->object.shown.entry[index].object = &video->object.ram[video->object.shown.entry[index].index];
+    }
+}
+
+int dmgl_video_initialize(dmgl_video_t *const video)
+{
+    if (!(video->ram = dmgl_page_allocate(0)))
+    {
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+int dmgl_video_observe(dmgl_video_t *const video, uint8_t width, uint8_t height, uint8_t stack)
+{
+    uint8_t *data = NULL;
+    if (!width || !height || !stack)
+    { /* OBSERVATIONS ARE DISABLED */
+        free(video->observe.data);
+        video->observe.data = NULL;
+        video->observe.width = 0;
+        video->observe.height = 0;
+        video->observe.stack = 0;
+        return EXIT_SUCCESS;
+    }
+    if ((width > 160) || (height > 144))
+    {
+        return DMGL_ERROR("Invalid observation size -- %ux%u", width, height);
+    }
+    if (video->observe.data && (video->observe.width == width) && (video->observe.height == height) && (video->observe.stack == stack))
+    {
+        return EXIT_SUCCESS;
+    }
+    if (!(data = realloc(video->observe.data, width * height * (stack + 1))))
+    { /* ONE FRAME MORE THAN THE STACK, SO THE FRAME BEING RENDERED NEVER OVERWRITES THE OLDEST */
+        return DMGL_ERROR("Failed to allocate observation buffer -- %u bytes", width * height * (stack + 1));
+    }
+    video->observe.data = data;
+    video->observe.width = width;
+    video->observe.height = height;
+    video->observe.stack = stack;
+    video->observe.index = 0;
+    video->observe.count = 0;
+    memset(data, GRAY[0], width * height);
+    for (uint8_t x = 0; x < width; ++x)
+    {
+        video->observe.column[x] = (x * 160) / width;
+    }
+    memset(video->observe.row, 0xFF, sizeof (video->observe.row));
+    for (uint8_t y = 0; y < height; ++y)
+    { /* AT MOST ONE OUTPUT ROW SAMPLES EACH LINE, SINCE THE HEIGHT NEVER EXCEEDS 144 */
+        video->observe.row[(y * 144) / height] = y;
+    }
+    return EXIT_SUCCESS;
+}
+
+uint32_t dmgl_video_observation(const dmgl_video_t *const video, uint8_t *const data)
+{
+    uint32_t length = video->observe.width * video->observe.height;
+    for (uint8_t frame = 0; video->observe.data && (frame < video->observe.stack); ++frame)
+    { /* OLDEST FRAME FIRST, WITH FRAMES NOT YET RENDERED LEFT BLACK */
+        if (frame < (video->observe.stack - video->observe.count))
+        {
+            memset(data + (frame * length), 0, length);
+        }
+        else
+        {
+            memcpy(data + (frame * length), video->observe.data + (((video->observe.index + frame + 1) % (video->observe.stack + 1)) * length), length);
+        }
+    }
+    return video->observe.data ? (length * video->observe.stack) : 0;
 }
 
 uint8_t dmgl_video_read(const dmgl_video_t *const video, uint16_t address)
@@ -322,7 +461,7 @@ uint8_t dmgl_video_read(const dmgl_video_t *const video, uint16_t address)
         case 0x8000 ... 0x9FFF: /* VIDEO RAM */
             if (!video->control.enabled || (video->status.mode < 3)) /* HBLANK-SEARCH */
             {
-                result = video->ram[address - 0x8000];
+                result = video->ram->data[address - 0x8000];
             }
             break;
         case 0xFE00 ... 0xFE9F: /* OBJECT RAM */
@@ -370,6 +509,89 @@ uint8_t dmgl_video_read(const dmgl_video_t *const video, uint16_t address)
     return result;
 }
 
+void dmgl_video_state_check(const dmgl_video_t *const video, dmgl_state_t *const state)
+{ /* THE FIELDS A LOAD REJECTS, READ WITHOUT CHANGING ANYTHING (KEEP IN STEP WITH THE LOAD BELOW) */
+    dmgl_state_skip(state, sizeof (video->ram->data) + (3 * sizeof (uint8_t)) + sizeof (uint16_t) + (3 * sizeof (uint8_t))
+        + sizeof (video->object.ram));
+    if (dmgl_state_read_8(state) > 10)
+    {
+        state->overflow = true;
+        return;
+    }
+    dmgl_state_skip(state, 10 + (4 * sizeof (uint8_t)) + (2 * sizeof (uint16_t)) + (3 * sizeof (uint8_t)));
+}
+
+void dmgl_video_state_load(dmgl_video_t *const video, dmgl_state_t *const state)
+{
+    dmgl_state_read(state, dmgl_page_write(&video->ram), sizeof (video->ram->data));
+    video->background.palette.raw = dmgl_state_read_8(state);
+    video->control.raw = dmgl_state_read_8(state);
+    video->line.coincidence = dmgl_state_read_8(state);
+    video->line.x = dmgl_state_read_16(state);
+    video->line.y = dmgl_state_read_8(state);
+    video->object.palette[0].raw = dmgl_state_read_8(state);
+    video->object.palette[1].raw = dmgl_state_read_8(state);
+    dmgl_state_read(state, video->object.ram, sizeof (video->object.ram));
+    video->object.shown.count = dmgl_state_read_8(state);
+    if (video->object.shown.count > 10)
+    {
+        state->overflow = true;
+        video->object.shown.count = 0;
+    }
+    for (uint8_t index = 0; index < 10; ++index)
+    { /* OBJECT POINTERS ARE STORED AS OBJECT RAM INDICES */
+        dmgl_object_entry_t *entry = &video->object.shown.entry[index];
+        entry->index = dmgl_state_read_8(state) % 40;
+        entry->object = &video->object.ram[entry->index];
+    }
+    video->scroll.x = dmgl_state_read_8(state);
+    video->scroll.y = dmgl_state_read_8(state);
+    video->status.raw = dmgl_state_read_8(state);
+    video->transfer.delay = dmgl_state_read_8(state);
+    video->transfer.destination = dmgl_state_read_16(state);
+    video->transfer.source = dmgl_state_read_16(state);
+    video->window.counter = dmgl_state_read_8(state);
+    video->window.x = dmgl_state_read_8(state);
+    video->window.y = dmgl_state_read_8(state);
+}
+
+void dmgl_video_state_save(const dmgl_video_t *const video, dmgl_state_t *const state)
+{
+    dmgl_state_write(state, video->ram->data, sizeof (video->ram->data));
+    dmgl_state_write_8(state, video->background.palette.raw);
+    dmgl_state_write_8(state, video->control.raw);
+    dmgl_state_write_8(state, video->line.coincidence);
+    dmgl_state_write_16(state, video->line.x);
+    dmgl_state_write_8(state, video->line.y);
+    dmgl_state_write_8(state, video->object.palette[0].raw);
+    dmgl_state_write_8(state, video->object.palette[1].raw);
+    dmgl_state_write(state, video->object.ram, sizeof (video->object.ram));
+    dmgl_state_write_8(state, video->object.shown.count);
+    for (uint8_t index = 0; index < 10; ++index)
+    {
+        dmgl_state_write_8(state, video->object.shown.entry[index].index);
+    }
+    dmgl_state_write_8(state, video->scroll.x);
+    dmgl_state_write_8(state, video->scroll.y);
+    dmgl_state_write_8(state, video->status.raw);
+    dmgl_state_write_8(state, video->transfer.delay);
+    dmgl_state_write_16(state, video->transfer.destination);
+    dmgl_state_write_16(state, video->transfer.source);
+    dmgl_state_write_8(state, video->window.counter);
+    dmgl_state_write_8(state, video->window.x);
+    dmgl_state_write_8(state, video->window.y);
+}
+
+void dmgl_video_uninitialize(dmgl_video_t *const video)
+{
+    dmgl_page_free(video->ram);
+    video->ram = NULL;
+    free(video->color);
+    video->color = NULL;
+    free(video->observe.data);
+    video->observe.data = NULL;
+}
+
 void dmgl_video_write(dmgl_video_t *const video, uint16_t address, uint8_t value)
 {
     switch (address)
@@ -377,7 +599,7 @@ void dmgl_video_write(dmgl_video_t *const video, uint16_t address, uint8_t value
         case 0x8000 ... 0x9FFF: /* VIDEO RAM */
             if (!video->control.enabled || (video->status.mode < 3)) /* HBLANK-SEARCH */
             {
-                video->ram[address - 0x8000] = value;
+                dmgl_page_write(&video->ram)[address - 0x8000] = value;
             }
             break;
         case 0xFE00 ... 0xFE9F: /* OBJECT RAM */
@@ -390,7 +612,10 @@ void dmgl_video_write(dmgl_video_t *const video, uint16_t address, uint8_t value
             video->control.raw = value;
             if (!video->control.enabled)
             {
-                memset(video->color, 0, sizeof (video->color));
+                if (video->color)
+                {
+                    memset(video->color, 0, sizeof (*video->color));
+                }
             }
             break;
         case 0xFF41: /* STAT */
@@ -409,6 +634,7 @@ void dmgl_video_write(dmgl_video_t *const video, uint16_t address, uint8_t value
             video->transfer.delay = 4;
             video->transfer.destination = 0xFE00;
             video->transfer.source = value << 8;
+            ++video->telemetry->transfer;
             break;
         case 0xFF47: /* BGP */
             video->background.palette.raw = value;
@@ -33,6 +33,18 @@ typedef struct
     const dmgl_object_t *object;
 } dmgl_object_entry_t;
 
+typedef struct
+{
+    uint8_t *data;
+    uint8_t width;
+    uint8_t height;
+    uint8_t stack;
+    uint8_t index;
+    uint8_t count;
+    uint8_t column[160];
+    uint8_t row[144];
+} dmgl_observe_t;
+
 typedef union
 {
     struct
@@ -47,8 +59,9 @@ typedef union
 
 typedef struct
 {
-    uint8_t ram[0x2000];
-    uint8_t color[160][144];
+    dmgl_page_t *ram;
+    uint8_t (*color)[160][144];
+    dmgl_telemetry_t *telemetry;
     struct
     {
         dmgl_palette_t palette;
@@ -73,6 +86,7 @@ typedef struct
         uint8_t coincidence;
         uint16_t x;
         uint8_t y;
+        uint8_t color[160];
     } line;
     struct
     {
@@ -84,6 +98,7 @@ typedef struct
             dmgl_object_entry_t entry[10];
         } shown;
     } object;
+    dmgl_observe_t observe;
     struct
     {
         uint8_t x;
@@ -118,7 +133,15 @@ typedef struct
 
 bool dmgl_video_clock(dmgl_video_t *const video);
 const uint8_t (*dmgl_video_color(dmgl_video_t *const video))[160][144];
+void dmgl_video_fork(dmgl_video_t *const video, const dmgl_video_t *const parent);
+int dmgl_video_initialize(dmgl_video_t *const video);
+int dmgl_video_observe(dmgl_video_t *const video, uint8_t width, uint8_t height, uint8_t stack);
+uint32_t dmgl_video_observation(const dmgl_video_t *const video, uint8_t *const data);
 uint8_t dmgl_video_read(const dmgl_video_t *const video, uint16_t address);
+void dmgl_video_state_check(const dmgl_video_t *const video, dmgl_state_t *const state);
+void dmgl_video_state_load(dmgl_video_t *const video, dmgl_state_t *const state);
+void dmgl_video_state_save(const dmgl_video_t *const video, dmgl_state_t *const state);
+void dmgl_video_uninitialize(dmgl_video_t *const video);
 void dmgl_video_write(dmgl_video_t *const video, uint16_t address, uint8_t value);
 
 #endif /* DMGL_VIDEO_H_ */
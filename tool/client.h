@@ -8,6 +8,12 @@
 
 #include <dmgl.h>
 
+#define CLIENT_PROFILE 1024
+#define CLIENT_REWIND 2
+#define CLIENT_REWIND_LENGTH (16 * 1024 * 1024)
+#define CLIENT_SAVE 60
+#define CLIENT_TELEMETRY 60
+
 int client_initialize(const char *const title, uint8_t scale);
 uint8_t client_output(uint8_t value);
 int client_poll(bool (*state)[8]);
@@ -0,0 +1,36 @@
+/*
+ * SPDX-FileCopyrightText: 2023 David Jolly <majestic53@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifdef CLIENT_HEADLESS
+
+#include <stdlib.h>
+#include <client.h>
+
+int client_initialize(const char *const title, uint8_t scale)
+{
+    return EXIT_SUCCESS;
+}
+
+uint8_t client_output(uint8_t value)
+{
+    return 1;
+}
+
+int client_poll(bool (*state)[8])
+{
+    return EXIT_SUCCESS;
+}
+
+int client_sync(const uint8_t (*color)[160][144], uint8_t palette, const float (*sample)[735])
+{
+    return EXIT_SUCCESS;
+}
+
+void client_uninitialize(void)
+{
+    return;
+}
+
+#endif /* CLIENT_HEADLESS */
@@ -7,6 +7,7 @@
 
 #include <SDL.h>
 #include <stdbool.h>
+#include <client.h>
 
 static const uint32_t PALETTE[][4] =
 {
@@ -204,6 +205,10 @@ int client_poll(bool (*state)[8])
             case SDL_KEYUP:
                 if (!event.key.repeat)
                 {
+                    if ((event.type == SDL_KEYDOWN) && (event.key.keysym.scancode == SDL_SCANCODE_F5))
+                    { /* WARM-START CACHE */
+                        dmgl_cache_save();
+                    }
                     for (uint8_t button = 0; button < 8; ++button)
                     {
                         if (SCANCODE[button] == event.key.keysym.scancode)
@@ -220,6 +225,10 @@ int client_poll(bool (*state)[8])
                 break;
         }
     }
+    if (SDL_GetKeyboardState(NULL)[SDL_SCANCODE_BACKSPACE])
+    { /* REWIND */
+        dmgl_rewind(CLIENT_REWIND + 1);
+    }
     return EXIT_SUCCESS;
 }
 
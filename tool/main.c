@@ -10,28 +10,64 @@
 #include <stdlib.h>
 #include <string.h>
 #include <client.h>
-#include "pokered.h"
 
 static const char *DESCRIPTION[] =
 {
+    "Record code coverage beside the ROM",
+    "Record input on exact cycles",
+    "Skip bootrom sequence",
+    "Stop after a number of frames",
+    "Record memory-access heatmap",
     "Show help information",
+    "Play input movie",
     "Set window palette",
+    "Record input movie",
     "Set window scaling",
+    "Report telemetry (- to print, or a Prometheus file)",
+    "Record execution trace",
     "Show version information",
+    "Start from the warm-start cache",
 };
 
 static const struct option OPTION[] =
 {
+    { "coverage", no_argument, NULL, 'C', },
+    { "cycle", no_argument, NULL, 'c', },
+    { "fast", no_argument, NULL, 'f', },
+    { "frames", required_argument, NULL, 'F', },
+    { "heatmap", required_argument, NULL, 'H', },
     { "help", no_argument, NULL, 'h', },
+    { "movie", required_argument, NULL, 'm', },
     { "palette", required_argument, NULL, 'p', },
+    { "record", required_argument, NULL, 'r', },
     { "scale", required_argument, NULL, 's', },
+    { "telemetry", required_argument, NULL, 'T', },
+    { "trace", required_argument, NULL, 't', },
     { "version", no_argument, NULL, 'v', },
+    { "warm", no_argument, NULL, 'w', },
     { NULL, 0, NULL, 0, },
 };
 
+static const char *REGION[] =
+{
+    "rom", "video", "cartridge", "work", "object", "io", "high",
+};
+
+static const char *INTERRUPT[] =
+{
+    "vblank", "status", "timer", "serial", "input",
+};
+
 static struct
 {
+    bool coverage;
+    bool warm;
+    char *movie;
     char *path[2];
+    char *telemetry;
+    uint32_t frame;
+    uint32_t frames;
+    dmgl_telemetry_t last;
     dmgl_t context;
 }
 g_main =
@@ -46,6 +82,15 @@ g_main =
             .sync = client_sync,
             .uninitialize = client_uninitialize,
         },
+        .ram =
+        {
+            .interval = CLIENT_SAVE,
+        },
+        .rewind =
+        {
+            .interval = CLIENT_REWIND,
+            .length = CLIENT_REWIND_LENGTH,
+        },
     },
 };
 
@@ -115,64 +160,228 @@ static bool file_write(const char *const path, const uint8_t *const data, uint32
     return result;
 }
 
-static int ram_load(const char *const path, uint8_t **data, uint32_t *length)
+static int movie_load(const char *const path, uint8_t **data, uint32_t *length)
+{
+    if (path && !g_main.context.movie.record && !file_read(path, data, length))
+    {
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+static int movie_save(const char *const path, const uint8_t *const data, uint32_t length)
 {
-    if (!file_exists(path))
+    if (path && g_main.context.movie.record && !file_write(path, data, length))
     {
-        *length = 17 * 0x2000;
-        if (!(*data = buffer_allocate(*length)))
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+static int ram_load(const char *const path, uint8_t **data, uint32_t *length)
+{
+    if (g_main.movie)
+    { /* MOVIES RUN FROM A PRIVATE COPY, SO THE SAVE A RECORDING STARTED FROM IS STILL THERE TO REPLAY IT */
+        if (!file_exists(path))
+        {
+            *length = 17 * 0x2000;
+            if (!(*data = buffer_allocate(*length)))
+            {
+                return EXIT_FAILURE;
+            }
+        }
+        else if (!file_read(path, data, length))
         {
             return EXIT_FAILURE;
         }
     }
-    else if (!file_read(path, data, length))
+    else if (dmgl_save_map(path, data, length) != EXIT_SUCCESS)
     {
+        fprintf(stderr, "%s\n", dmgl_error());
         return EXIT_FAILURE;
     }
     return EXIT_SUCCESS;
 }
 
-static int ram_save(const char *const path, const uint8_t *const data, uint32_t length)
+static void ram_unload(uint8_t *const data)
 {
-    if (!file_write(path, data, length))
+    if (g_main.movie)
     {
+        buffer_free(data);
+    }
+    else
+    {
+        dmgl_save_unmap(data);
+    }
+}
+
+static int rom_load(const char *const path, uint8_t **data, uint32_t *length)
+{
+    if (dmgl_rom_map(path, data, length) != EXIT_SUCCESS)
+    {
+        fprintf(stderr, "%s\n", dmgl_error());
         return EXIT_FAILURE;
     }
     return EXIT_SUCCESS;
 }
 
-static int rom_load( uint8_t **data, uint32_t *length)
+static void rom_unload(const uint8_t *const data)
 {
-   *length = 1048576;
-    *data = (uint8_t *)pokered_gb;
-    return EXIT_SUCCESS;
+    dmgl_rom_unmap(data);
+}
+
+static void telemetry_print(const dmgl_telemetry_t *const telemetry)
+{ /* RATES OVER THE FRAMES SINCE THE LAST REPORT */
+    const dmgl_telemetry_t *const last = &g_main.last;
+    uint64_t cycles = telemetry->cycle - last->cycle, frames = telemetry->frame - last->frame;
+    fprintf(stdout, "frame %llu: %llu cycles/frame, %.1f%% halted, %llu instructions/frame, %llu dma, %llu banks, %llu samples\n",
+        (unsigned long long)telemetry->frame, (unsigned long long)(frames ? (cycles / frames) : 0),
+        cycles ? ((100.0 * (telemetry->halted - last->halted)) / cycles) : 0, (unsigned long long)(frames ? ((telemetry->instruction - last->instruction) / frames) : 0),
+        (unsigned long long)(telemetry->transfer - last->transfer), (unsigned long long)(telemetry->bank - last->bank), (unsigned long long)(telemetry->sample - last->sample));
+    fprintf(stdout, "  reads/writes:");
+    for (uint8_t region = 0; region < DMGL_REGION_COUNT; ++region)
+    {
+        fprintf(stdout, " %s %llu/%llu", REGION[region], (unsigned long long)(telemetry->read[region] - last->read[region]),
+            (unsigned long long)(telemetry->write[region] - last->write[region]));
+    }
+    fprintf(stdout, "\n  interrupts:");
+    for (uint8_t interrupt = 0; interrupt < 5; ++interrupt)
+    {
+        fprintf(stdout, " %s %llu", INTERRUPT[interrupt], (unsigned long long)(telemetry->interrupt[interrupt] - last->interrupt[interrupt]));
+    }
+    fprintf(stdout, "\n  host ms: emulate %.2f, poll %.2f, sync %.2f, capture %.2f, flush %.2f\n", (telemetry->host.emulate - last->host.emulate) / 1e6,
+        (telemetry->host.poll - last->host.poll) / 1e6, (telemetry->host.sync - last->host.sync) / 1e6,
+        (telemetry->host.capture - last->host.capture) / 1e6, (telemetry->host.flush - last->host.flush) / 1e6);
+}
+
+static void telemetry_write(const dmgl_telemetry_t *const telemetry)
+{
+    FILE *file = NULL;
+    char path[4096] = {};
+    snprintf(path, sizeof (path), "%s.tmp", g_main.telemetry);
+    if (!(file = fopen(path, "w")))
+    {
+        fprintf(stderr, "Failed to open file -- %s\n", path);
+        return;
+    }
+    fprintf(file, "# TYPE dmgl_frames_total counter\ndmgl_frames_total %llu\n", (unsigned long long)telemetry->frame);
+    fprintf(file, "# TYPE dmgl_cycles_total counter\ndmgl_cycles_total %llu\n", (unsigned long long)telemetry->cycle);
+    fprintf(file, "# TYPE dmgl_halted_cycles_total counter\ndmgl_halted_cycles_total %llu\n", (unsigned long long)telemetry->halted);
+    fprintf(file, "# TYPE dmgl_instructions_total counter\ndmgl_instructions_total %llu\n", (unsigned long long)telemetry->instruction);
+    fprintf(file, "# TYPE dmgl_memory_reads_total counter\n");
+    for (uint8_t region = 0; region < DMGL_REGION_COUNT; ++region)
+    {
+        fprintf(file, "dmgl_memory_reads_total{region=\"%s\"} %llu\n", REGION[region], (unsigned long long)telemetry->read[region]);
+    }
+    fprintf(file, "# TYPE dmgl_memory_writes_total counter\n");
+    for (uint8_t region = 0; region < DMGL_REGION_COUNT; ++region)
+    {
+        fprintf(file, "dmgl_memory_writes_total{region=\"%s\"} %llu\n", REGION[region], (unsigned long long)telemetry->write[region]);
+    }
+    fprintf(file, "# TYPE dmgl_interrupts_total counter\n");
+    for (uint8_t interrupt = 0; interrupt < 5; ++interrupt)
+    {
+        fprintf(file, "dmgl_interrupts_total{type=\"%s\"} %llu\n", INTERRUPT[interrupt], (unsigned long long)telemetry->interrupt[interrupt]);
+    }
+    fprintf(file, "# TYPE dmgl_dma_total counter\ndmgl_dma_total %llu\n", (unsigned long long)telemetry->transfer);
+    fprintf(file, "# TYPE dmgl_bank_switches_total counter\ndmgl_bank_switches_total %llu\n", (unsigned long long)telemetry->bank);
+    fprintf(file, "# TYPE dmgl_audio_samples_total counter\ndmgl_audio_samples_total %llu\n", (unsigned long long)telemetry->sample);
+    fprintf(file, "# TYPE dmgl_host_seconds_total counter\n");
+    fprintf(file, "dmgl_host_seconds_total{subsystem=\"emulate\"} %.9f\n", telemetry->host.emulate / 1e9);
+    fprintf(file, "dmgl_host_seconds_total{subsystem=\"poll\"} %.9f\n", telemetry->host.poll / 1e9);
+    fprintf(file, "dmgl_host_seconds_total{subsystem=\"sync\"} %.9f\n", telemetry->host.sync / 1e9);
+    fprintf(file, "dmgl_host_seconds_total{subsystem=\"capture\"} %.9f\n", telemetry->host.capture / 1e9);
+    fprintf(file, "dmgl_host_seconds_total{subsystem=\"flush\"} %.9f\n", telemetry->host.flush / 1e9);
+    if (fclose(file) || rename(path, g_main.telemetry))
+    { /* RENAMED INTO PLACE, SO A SCRAPER NEVER READS A PARTIAL FILE */
+        fprintf(stderr, "Failed to write file -- %s\n", g_main.telemetry);
+    }
+}
+
+static void telemetry_report(void)
+{
+    dmgl_telemetry_t telemetry = {};
+    if (dmgl_telemetry(NULL, &telemetry) != EXIT_SUCCESS)
+    {
+        return;
+    }
+    if (!strcmp(g_main.telemetry, "-"))
+    {
+        telemetry_print(&telemetry);
+    }
+    else
+    {
+        telemetry_write(&telemetry);
+    }
+    g_main.last = telemetry;
+}
+
+static int frames_poll(bool (*state)[8])
+{
+    if (++g_main.frame > g_main.frames)
+    { /* ENDS THE RUN LIKE CLOSING THE WINDOW */
+        return EXIT_FAILURE;
+    }
+    return client_poll(state);
+}
+
+static int telemetry_sync(const uint8_t (*color)[160][144], uint8_t palette, const float (*sample)[735])
+{
+    dmgl_telemetry_t telemetry = {};
+    if ((dmgl_telemetry(NULL, &telemetry) == EXIT_SUCCESS) && ((telemetry.frame - g_main.last.frame) >= CLIENT_TELEMETRY))
+    {
+        telemetry_report();
+    }
+    return client_sync(color, palette, sample);
+}
+
+static void telemetry_uninitialize(void)
+{
+    telemetry_report(); /* THE INSTANCE IS STILL CURRENT UNTIL THIS RETURNS */
+    client_uninitialize();
 }
 
 static int run(void)
 {
     int result = EXIT_SUCCESS;
-    if ((result = rom_load(&g_main.context.rom.data, &g_main.context.rom.length)) == EXIT_SUCCESS)
+    if ((result = rom_load(g_main.path[0], &g_main.context.rom.data, &g_main.context.rom.length)) == EXIT_SUCCESS)
     {
         if ((result = ram_load(g_main.path[1], &g_main.context.ram.data, &g_main.context.ram.length)) == EXIT_SUCCESS)
         {
-            if ((result = dmgl(&g_main.context)) == EXIT_SUCCESS)
+            if ((result = movie_load(g_main.movie, &g_main.context.movie.data, &g_main.context.movie.length)) == EXIT_SUCCESS)
             {
-                result = ram_save(g_main.path[1], g_main.context.ram.data, g_main.context.ram.length);
+                if ((result = dmgl(&g_main.context)) == EXIT_SUCCESS)
+                {
+                    result = movie_save(g_main.movie, g_main.context.movie.data, g_main.context.movie.length);
+                }
+                else
+                {
+                    fprintf(stderr, "%s\n", dmgl_error());
+                }
+#ifdef DMGL_PROFILE
+                if (dmgl_profile_dump(g_main.path[0]) != EXIT_SUCCESS)
+                { /* THE PROFILE IS WRITTEN BESIDE THE ROM */
+                    fprintf(stderr, "%s\n", dmgl_error());
+                }
+#endif /* DMGL_PROFILE */
+                buffer_free(g_main.context.movie.data);
             }
-            else
-            {
-                fprintf(stderr, "%s\n", dmgl_error());
-            }
-            buffer_free(g_main.context.ram.data);
+            ram_unload(g_main.context.ram.data);
         }
-        buffer_free(g_main.context.rom.data);
+        rom_unload(g_main.context.rom.data);
     }
     return result;
 }
 
 static void usage(void)
 {
-   fprintf(stdout,"ONLY USE FOR TESTING PURPOSES\n");
+    fprintf(stdout, "ONLY USE FOR TESTING PURPOSES\n\nUsage: dmgl [options] FILE\n\nOptions:\n");
+    for (uint32_t index = 0; index < (sizeof (DESCRIPTION) / sizeof (*DESCRIPTION)); ++index)
+    {
+        char flag[32] = {};
+        snprintf(flag, sizeof (flag), "--%s%s", OPTION[index].name, (OPTION[index].has_arg == required_argument) ? " ARG" : "");
+        fprintf(stdout, "   -%c, %-20s %s\n", OPTION[index].val, flag, DESCRIPTION[index]);
+    }
 }
 
 static void version(void)
@@ -182,27 +391,64 @@ static void version(void)
 }
 
 int main(int argc, char *argv[])
-{   argv[1] = "pokered.gb";
-    argc += 1;
-
+{
     uint32_t length = 0;
     int option = 0, result = EXIT_SUCCESS;
-    while ((option = getopt_long(argc, argv, "hp:s:v", OPTION, NULL)) != -1)
+    char coverage[4096] = {};
+#ifdef DMGL_PROFILE
+    char profile[2][4096] = {};
+#endif /* DMGL_PROFILE */
+    while ((option = getopt_long(argc, argv, "CcfF:H:hm:p:r:s:T:t:vw", OPTION, NULL)) != -1)
     {
         switch (option)
         {
+            case 'C': /* COVERAGE */
+                g_main.coverage = true;
+                break;
+            case 'c': /* CYCLE */
+                g_main.context.movie.cycle = true;
+                break;
+            case 'f': /* FAST */
+                g_main.context.bootrom.skip = true;
+                break;
+            case 'F': /* FRAMES */
+                g_main.frames = strtoul(optarg, NULL, 10);
+                g_main.context.client.poll = frames_poll;
+                break;
+            case 'H': /* HEATMAP */
+                g_main.context.heatmap.path = optarg;
+                break;
             case 'h': /* HELP */
                 usage();
                 return EXIT_SUCCESS;
+            case 'm': /* MOVIE */
+                g_main.context.movie.record = false;
+                g_main.movie = optarg;
+                break;
             case 'p': /* PALETTE */
                 g_main.context.palette = strtol(optarg, NULL, 10);
                 break;
+            case 'r': /* RECORD */
+                g_main.context.movie.record = true;
+                g_main.movie = optarg;
+                break;
             case 's': /* SCALE */
                 g_main.context.scale = strtol(optarg, NULL, 10);
                 break;
+            case 'T': /* TELEMETRY */
+                g_main.telemetry = optarg;
+                g_main.context.client.sync = telemetry_sync;
+                g_main.context.client.uninitialize = telemetry_uninitialize;
+                break;
+            case 't': /* TRACE */
+                g_main.context.trace.path = optarg;
+                break;
             case 'v': /* VERSION */
                 version();
                 return EXIT_SUCCESS;
+            case 'w': /* WARM */
+                g_main.warm = true;
+                break;
             case '?':
             default:
                 return EXIT_FAILURE;
@@ -218,17 +464,47 @@ int main(int argc, char *argv[])
         }
         g_main.path[0] = argv[option];
     }
+#ifdef PLATFORM_WEB
+    if (!g_main.path[0])
+    { /* THE WEB BUILD EMBEDS ITS ROM INTO THE VIRTUAL FILESYSTEM */
+        g_main.path[0] = "pokered.gb";
+    }
+#endif /* PLATFORM_WEB */
     if (!g_main.path[0] || !strlen(g_main.path[0]))
     {
         usage();
         return EXIT_FAILURE;
     }
+#ifdef CLIENT_HEADLESS
+    if (g_main.context.movie.record && !g_main.frames)
+    { /* WITHOUT A WINDOW TO CLOSE, NOTHING ELSE ENDS A RECORDING */
+        fprintf(stderr, "Recording without a window requires --frames\n");
+        return EXIT_FAILURE;
+    }
+#endif /* CLIENT_HEADLESS */
     length = strlen(g_main.path[0]) + strlen(".sav") + 1;
     if (!(g_main.path[1] = buffer_allocate(length)))
     {
         return EXIT_FAILURE;
     }
     snprintf(g_main.path[1], length, "%s.sav", g_main.path[0]);
+    if (g_main.warm)
+    { /* CACHES ARE WRITTEN BESIDE THE ROM */
+        g_main.context.cache.path = g_main.path[0];
+    }
+    if (g_main.coverage)
+    { /* KEPT BESIDE THE ROM, SO EACH RUN ADDS TO THE LAST */
+        snprintf(coverage, sizeof (coverage), "%s.dmv", g_main.path[0]);
+        g_main.context.coverage.path = coverage;
+    }
+#ifdef DMGL_PROFILE
+    snprintf(profile[0], sizeof (profile[0]), "%s-profile.folded", g_main.path[0]);
+    length = strrchr(g_main.path[0], '.') ? (strrchr(g_main.path[0], '.') - g_main.path[0]) : strlen(g_main.path[0]);
+    snprintf(profile[1], sizeof (profile[1]), "%.*s.sym", (int)length, g_main.path[0]);
+    g_main.context.profile.path = profile[0];
+    g_main.context.profile.symbols = file_exists(profile[1]) ? profile[1] : NULL; /* RGBDS WRITES game.sym BESIDE game.gb */
+    g_main.context.profile.interval = CLIENT_PROFILE;
+#endif /* DMGL_PROFILE */
     result = run();
     buffer_free(g_main.path[1]);
     return result;
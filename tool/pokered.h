@@ -1 +0,0 @@
-extern unsigned char pokered_gb[];
\ No newline at end of file
@@ -0,0 +1,47 @@
+/*
+ * SPDX-FileCopyrightText: 2023 David Jolly <majestic53@gmail.com>
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <dmgl.h>
+
+static void decode(const dmgl_trace_t *const trace)
+{
+    char text[32] = {};
+    uint8_t length = dmgl_disassemble(text, sizeof (text), trace->pc, trace->opcode);
+    fprintf(stdout, "%012llu %02X:%04X  ", (unsigned long long)trace->cycle, trace->bank, trace->pc);
+    for (uint8_t index = 0; index < sizeof (trace->opcode); ++index)
+    { /* ONLY THE BYTES THE INSTRUCTION USES */
+        fprintf(stdout, (index < length) ? "%02X " : "   ", trace->opcode[index]);
+    }
+    fprintf(stdout, " %-16s AF=%04X BC=%04X DE=%04X HL=%04X SP=%04X IME=%u IE=%02X IF=%02X\n", text,
+        trace->af, trace->bc, trace->de, trace->hl, trace->sp, trace->interrupt.enabled, trace->interrupt.enable, trace->interrupt.flag);
+}
+
+int main(int argc, char *argv[])
+{
+    dmgl_trace_t trace = {};
+    dmgl_trace_reader_t *reader = NULL;
+    if (argc != 2)
+    {
+        fprintf(stderr, "Usage: %s FILE\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (!(reader = dmgl_trace_open(argv[1])))
+    {
+        fprintf(stderr, "%s\n", dmgl_error());
+        return EXIT_FAILURE;
+    }
+    while (dmgl_trace_next(reader, &trace) && !ferror(stdout))
+    {
+        decode(&trace);
+    }
+    if (dmgl_trace_close(reader) != EXIT_SUCCESS)
+    {
+        fprintf(stderr, "%s\n", dmgl_error());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}